@@ -0,0 +1,88 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/book_publisher.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/util/memory/pool.h"
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+
+using namespace flox;
+
+using BookUpdatePool = pool::Pool<BookUpdateEvent, 7>;
+
+// Publisher fed by a writer thread that keeps changing the top 10 levels
+class Fixture
+{
+ public:
+  Fixture()
+  {
+    _writer = std::thread(
+        [this]
+        {
+          BookUpdatePool pool;
+          for (int64_t n = 1; !_stop.load(std::memory_order_relaxed); ++n)
+          {
+            auto opt = pool.acquire();
+            auto& up = *opt;
+            up->update.symbol = 1;
+            up->update.type = n == 1 ? BookUpdateType::SNAPSHOT : BookUpdateType::DELTA;
+            up->seq = n;
+            up->update.bids.clear();
+            up->update.asks.clear();
+            for (int k = 0; k < 10; ++k)
+            {
+              up->update.bids.push_back({Price::fromDouble(100.0 - 0.1 * k), Quantity::fromRaw(n)});
+              up->update.asks.push_back({Price::fromDouble(100.1 + 0.1 * k), Quantity::fromRaw(n)});
+            }
+            publisher.onBookUpdate(*up);
+          }
+        });
+    while (publisher.version() == 0)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  ~Fixture()
+  {
+    _stop.store(true);
+    _writer.join();
+  }
+
+  BookPublisher<10> publisher{1, 1, Price::fromDouble(0.1)};
+
+ private:
+  std::atomic<bool> _stop{false};
+  std::thread _writer;
+};
+
+static void BM_TopOfBookRead(benchmark::State& state)
+{
+  Fixture f;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(f.publisher.topOfBook());
+  }
+}
+BENCHMARK(BM_TopOfBookRead)->UseRealTime();
+
+static void BM_DepthSnapshotRead(benchmark::State& state)
+{
+  Fixture f;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(f.publisher.depth());
+  }
+}
+BENCHMARK(BM_DepthSnapshotRead)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,135 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/bus/trade_bus.h"
+#include "flox/book/events/trade_event.h"
+#include "flox/common.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace flox;
+
+namespace
+{
+
+using MultiProducerTradeBus = TradeBus;
+using SingleProducerTradeBus = EventBus<TradeEvent, config::DEFAULT_EVENTBUS_CAPACITY,
+                                        config::DEFAULT_EVENTBUS_MAX_CONSUMERS, SingleProducer>;
+
+class CountingSubscriber : public IMarketDataSubscriber
+{
+ public:
+  void onTrade(const TradeEvent&) override { _count.fetch_add(1, std::memory_order_relaxed); }
+  SubscriberId id() const override { return 1; }
+
+ private:
+  std::atomic<uint64_t> _count{0};
+};
+
+std::vector<TradeEvent> makeTrades(size_t n)
+{
+  std::vector<TradeEvent> trades(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    trades[i].trade.symbol = 1;
+    trades[i].trade.price = Price::fromDouble(100.0 + static_cast<double>(i % 16) * 0.1);
+    trades[i].trade.quantity = Quantity::fromDouble(1.0);
+    trades[i].trade.isBuy = (i % 2) == 0;
+  }
+  return trades;
+}
+
+}  // namespace
+
+template <typename Bus>
+static void BM_EventBus_PublishSingle(benchmark::State& state)
+{
+  const size_t batch = static_cast<size_t>(state.range(0));
+  const auto trades = makeTrades(batch);
+
+  auto bus = std::make_unique<Bus>();
+  CountingSubscriber sub;
+  bus->subscribe(&sub);
+  bus->start();
+
+  for (auto _ : state)
+  {
+    for (const auto& t : trades)
+    {
+      bus->publish(t);
+    }
+  }
+
+  bus->flush();
+  bus->stop();
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK_TEMPLATE(BM_EventBus_PublishSingle, MultiProducerTradeBus)->Arg(1)->Arg(8)->Arg(64)->Arg(256)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EventBus_PublishSingle, SingleProducerTradeBus)->Arg(1)->Arg(8)->Arg(64)->Arg(256)->UseRealTime();
+
+template <typename Bus>
+static void BM_EventBus_PublishBatch(benchmark::State& state)
+{
+  const size_t batch = static_cast<size_t>(state.range(0));
+  const auto trades = makeTrades(batch);
+
+  auto bus = std::make_unique<Bus>();
+  CountingSubscriber sub;
+  bus->subscribe(&sub);
+  bus->start();
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(bus->publishBatch(trades));
+  }
+
+  bus->flush();
+  bus->stop();
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK_TEMPLATE(BM_EventBus_PublishBatch, MultiProducerTradeBus)->Arg(1)->Arg(8)->Arg(64)->Arg(256)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EventBus_PublishBatch, SingleProducerTradeBus)->Arg(1)->Arg(8)->Arg(64)->Arg(256)->UseRealTime();
+
+template <typename Bus>
+static void BM_EventBus_ClaimCommit(benchmark::State& state)
+{
+  const size_t batch = static_cast<size_t>(state.range(0));
+  const auto trades = makeTrades(batch);
+
+  auto bus = std::make_unique<Bus>();
+  CountingSubscriber sub;
+  bus->subscribe(&sub);
+  bus->start();
+
+  for (auto _ : state)
+  {
+    const auto claim = bus->claim(batch);
+    for (size_t i = 0; i < batch; ++i)
+    {
+      auto& ev = bus->emplaceAt(claim.first + static_cast<int64_t>(i));
+      ev.trade = trades[i].trade;
+    }
+    bus->commit(claim);
+  }
+
+  bus->flush();
+  bus->stop();
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK_TEMPLATE(BM_EventBus_ClaimCommit, MultiProducerTradeBus)->Arg(1)->Arg(8)->Arg(64)->Arg(256)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EventBus_ClaimCommit, SingleProducerTradeBus)->Arg(1)->Arg(8)->Arg(64)->Arg(256)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,114 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/market_by_order_book.h"
+#include "flox/book/mbo_update.h"
+#include "flox/common.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace flox;
+
+// A replayable add/modify/delete stream around a touch at 20000.0, ending with every order
+// deleted so the same stream can be applied again to the same book
+static std::vector<MboUpdate> makeStream(size_t messages, size_t resting, int64_t spreadTicks)
+{
+  std::mt19937_64 rng(42);
+  const int64_t tick = Price::fromDouble(0.1).raw();
+  const int64_t mid = Price::fromDouble(20000.0).raw();
+
+  std::vector<MboUpdate> out;
+  out.reserve(messages + resting);
+  std::vector<MboUpdate> live;
+  OrderId nextId = 1;
+
+  auto add = [&]
+  {
+    MboUpdate up{};
+    up.type = MboUpdateType::ADD;
+    up.orderId = nextId++;
+    up.side = rng() % 2 ? Side::BUY : Side::SELL;
+    const int64_t depth = 1 + static_cast<int64_t>(rng() % spreadTicks);
+    up.price = Price::fromRaw(up.side == Side::BUY ? mid - depth * tick : mid + depth * tick);
+    up.quantity = Quantity::fromDouble(1.0 + static_cast<double>(rng() % 10));
+    out.push_back(up);
+    live.push_back(up);
+  };
+
+  auto remove = [&](size_t i)
+  {
+    MboUpdate up = live[i];
+    up.type = MboUpdateType::DELETE;
+    out.push_back(up);
+    live[i] = live.back();
+    live.pop_back();
+  };
+
+  while (out.size() < messages)
+  {
+    const auto roll = rng() % 10;
+    if (live.size() < resting || roll < 4)
+    {
+      add();
+    }
+    else if (roll < 8)
+    {
+      remove(rng() % live.size());
+    }
+    else
+    {
+      MboUpdate& o = live[rng() % live.size()];
+      o.type = MboUpdateType::MODIFY;
+      o.quantity = Quantity::fromRaw(o.quantity.raw() / 2 + 1);
+      out.push_back(o);
+    }
+  }
+  while (!live.empty())
+  {
+    remove(live.size() - 1);
+  }
+  return out;
+}
+
+static void BM_MboApplyStream(benchmark::State& state)
+{
+  const auto stream = makeStream(1'000'000, static_cast<size_t>(state.range(0)), 200);
+  MarketByOrderBook book{static_cast<size_t>(state.range(0)) * 4};
+
+  for (auto _ : state)
+  {
+    for (const auto& up : stream)
+    {
+      benchmark::DoNotOptimize(book.apply(up));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(stream.size()));
+}
+BENCHMARK(BM_MboApplyStream)->Arg(1'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+static void BM_MboBestBidAsk(benchmark::State& state)
+{
+  const auto stream = makeStream(200'000, 50'000, 200);
+  MarketByOrderBook book{200'000};
+  for (size_t i = 0; i < stream.size() / 2; ++i)
+  {
+    book.apply(stream[i]);
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(book.bestBid());
+    benchmark::DoNotOptimize(book.bestAsk());
+  }
+}
+BENCHMARK(BM_MboBestBidAsk);
+
+BENCHMARK_MAIN();
@@ -14,6 +14,7 @@
 
 #include <benchmark/benchmark.h>
 #include <random>
+#include <vector>
 
 using namespace flox;
 
@@ -256,4 +257,274 @@ static void BM_ConsumeBids_Sparse(benchmark::State& state)
 }
 BENCHMARK(BM_ConsumeBids_Sparse)->Unit(benchmark::kMicrosecond);
 
+// A dense snapshot of kLevels asks upward and kLevels bids downward from 20000.0
+template <size_t Levels>
+static void applyDenseSnapshot(NLevelOrderBook<Levels>& book, BookUpdatePool& pool, int kLevels)
+{
+  auto opt = pool.acquire();
+  assert(opt);
+  auto& up = *opt;
+
+  up->update.type = BookUpdateType::SNAPSHOT;
+  up->update.asks.reserve(kLevels);
+  up->update.bids.reserve(kLevels);
+
+  const auto p0 = Price::fromDouble(20000.0);
+  const auto ts = Price::fromDouble(0.1).raw();
+
+  for (int i = 0; i < kLevels; ++i)
+  {
+    const auto q = Quantity::fromDouble(0.5 + (i % 10) * 0.15);
+    up->update.asks.emplace_back(Price::fromRaw(p0.raw() + int64_t(i + 1) * ts), q);
+    up->update.bids.emplace_back(Price::fromRaw(p0.raw() - int64_t(i) * ts), q);
+  }
+
+  book.applyBookUpdate(*up);
+}
+
+static void BM_FillAsks_Dense(benchmark::State& state)
+{
+  NLevelOrderBook<100000> book{Price::fromDouble(0.1)};
+  BookUpdatePool pool;
+  applyDenseSnapshot(book, pool, 49000);
+
+  const auto need = Quantity::fromDouble(250.0);
+  for (auto _ : state)
+  {
+    auto res = book.fillAsks(need);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(BM_FillAsks_Dense)->Unit(benchmark::kMicrosecond);
+
+static void BM_FillBids_Dense(benchmark::State& state)
+{
+  NLevelOrderBook<100000> book{Price::fromDouble(0.1)};
+  BookUpdatePool pool;
+  applyDenseSnapshot(book, pool, 49000);
+
+  const auto need = Quantity::fromDouble(250.0);
+  for (auto _ : state)
+  {
+    auto res = book.fillBids(need);
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(BM_FillBids_Dense)->Unit(benchmark::kMicrosecond);
+
+static void BM_AskDepthWithinBps(benchmark::State& state)
+{
+  NLevelOrderBook<100000> book{Price::fromDouble(0.1)};
+  BookUpdatePool pool;
+  applyDenseSnapshot(book, pool, 49000);
+
+  const auto bps = static_cast<uint32_t>(state.range(0));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(book.askDepthWithinBps(bps));
+  }
+}
+BENCHMARK(BM_AskDepthWithinBps)->Arg(5)->Arg(50)->Unit(benchmark::kNanosecond);
+
+static void BM_CumulativeAskDepth(benchmark::State& state)
+{
+  NLevelOrderBook<100000> book{Price::fromDouble(0.1)};
+  BookUpdatePool pool;
+  applyDenseSnapshot(book, pool, 49000);
+
+  std::vector<Quantity> out(static_cast<size_t>(state.range(0)));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(book.cumulativeAskDepth(out));
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_CumulativeAskDepth)->Arg(64)->Arg(1024)->Unit(benchmark::kNanosecond);
+
+static void BM_TopAsksVwap(benchmark::State& state)
+{
+  NLevelOrderBook<100000> book{Price::fromDouble(0.1)};
+  BookUpdatePool pool;
+  applyDenseSnapshot(book, pool, 49000);
+
+  for (auto _ : state)
+  {
+    auto res = book.topAsks(static_cast<size_t>(state.range(0)));
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(BM_TopAsksVwap)->Arg(10)->Arg(64)->Arg(256)->Unit(benchmark::kNanosecond);
+
+// Kernel against its scalar reference over n contiguous levels
+template <int64_t (*Kernel)(const Quantity*, size_t)>
+static void BM_DepthKernel(benchmark::State& state)
+{
+  std::vector<Quantity> levels(static_cast<size_t>(state.range(0)));
+  for (size_t i = 0; i < levels.size(); ++i)
+  {
+    levels[i] = Quantity::fromRaw(static_cast<int64_t>(1 + i % 97) * 10'000);
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(levels.data());
+    benchmark::DoNotOptimize(Kernel(levels.data(), levels.size()));
+  }
+}
+BENCHMARK_TEMPLATE(BM_DepthKernel, depth::sum)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_DepthKernel, depth::sumScalar)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_DepthKernel, depth::weightedSum)->Arg(64);
+BENCHMARK_TEMPLATE(BM_DepthKernel, depth::weightedSumScalar)->Arg(64);
+
+static void BM_SweepThinBook(benchmark::State& state)
+{
+  NLevelOrderBook<100000> book{Price::fromDouble(0.1)};
+  BookUpdatePool pool;
+
+  // Top levels at the center of the window, one resting level at each far end
+  auto snap = pool.acquire();
+  assert(snap);
+  (*snap)->update.type = BookUpdateType::SNAPSHOT;
+  (*snap)->update.bids = {{Price::fromDouble(5000.0), Quantity::fromDouble(1.0)},
+                          {Price::fromDouble(100.0), Quantity::fromDouble(1.0)}};
+  (*snap)->update.asks = {{Price::fromDouble(5000.1), Quantity::fromDouble(1.0)},
+                          {Price::fromDouble(9900.0), Quantity::fromDouble(1.0)}};
+  book.applyBookUpdate(**snap);
+
+  auto sweep = pool.acquire();
+  auto refill = pool.acquire();
+  assert(sweep && refill);
+  (*sweep)->update.type = (*refill)->update.type = BookUpdateType::DELTA;
+  (*sweep)->update.bids = {{Price::fromDouble(5000.0), Quantity::fromDouble(0.0)}};
+  (*sweep)->update.asks = {{Price::fromDouble(5000.1), Quantity::fromDouble(0.0)}};
+  (*refill)->update.bids = {{Price::fromDouble(5000.0), Quantity::fromDouble(1.0)}};
+  (*refill)->update.asks = {{Price::fromDouble(5000.1), Quantity::fromDouble(1.0)}};
+
+  for (auto _ : state)
+  {
+    book.applyBookUpdate(**sweep);
+    benchmark::DoNotOptimize(book.bestBid());
+    book.applyBookUpdate(**refill);
+    benchmark::DoNotOptimize(book.bestAsk());
+  }
+}
+BENCHMARK(BM_SweepThinBook)->Unit(benchmark::kNanosecond);
+
+// Small deltas near the touch of a resting book, followed by a top-10 imbalance and
+// depth-weighted mid read: maintained incrementally by the book, or recomputed per event
+template <typename Book>
+static void runTopAnalytics(benchmark::State& state, Book& book, auto&& read)
+{
+  BookUpdatePool pool;
+
+  auto snap = pool.acquire();
+  assert(snap);
+  (*snap)->update.type = BookUpdateType::SNAPSHOT;
+  for (int i = 0; i < 200; ++i)
+  {
+    (*snap)->update.bids.push_back({Price::fromDouble(5000.0 - 0.1 * i), Quantity::fromDouble(1.0 + i % 5)});
+    (*snap)->update.asks.push_back({Price::fromDouble(5000.1 + 0.1 * i), Quantity::fromDouble(1.0 + i % 5)});
+  }
+  book.applyBookUpdate(**snap);
+
+  std::mt19937 rng(42);
+  std::vector<pool::Handle<BookUpdateEvent>> deltas;
+  for (int k = 0; k < 32; ++k)
+  {
+    auto d = pool.acquire();
+    assert(d);
+    (*d)->update.type = BookUpdateType::DELTA;
+    for (int j = 0; j < 2; ++j)
+    {
+      // Levels 1..20 behind the touch: modified, emptied or refilled
+      const double off = 0.1 * static_cast<double>(1 + rng() % 20);
+      const auto qty = Quantity::fromDouble(rng() % 4 == 0 ? 0.0 : 1.0 + rng() % 5);
+      (*d)->update.bids.push_back({Price::fromDouble(5000.0 - off), qty});
+      (*d)->update.asks.push_back({Price::fromDouble(5000.1 + off), qty});
+    }
+    deltas.push_back(std::move(*d));
+  }
+
+  size_t n = 0;
+  for (auto _ : state)
+  {
+    book.applyBookUpdate(*deltas[n++ & 31]);
+    read(book);
+  }
+}
+
+static void BM_TopAnalytics_Incremental(benchmark::State& state)
+{
+  NLevelOrderBook<8192, 10> book{Price::fromDouble(0.1)};
+  runTopAnalytics(state, book,
+                  [](const auto& b)
+                  {
+                    benchmark::DoNotOptimize(b.topImbalance());
+                    benchmark::DoNotOptimize(b.depthWeightedMid());
+                  });
+}
+BENCHMARK(BM_TopAnalytics_Incremental)->Unit(benchmark::kNanosecond);
+
+static void BM_TopAnalytics_Recompute(benchmark::State& state)
+{
+  NLevelOrderBook<8192> book{Price::fromDouble(0.1)};
+  runTopAnalytics(state, book,
+                  [](const auto& b)
+                  {
+                    const auto bids = b.topBids(10);
+                    const auto asks = b.topAsks(10);
+                    const double bq = bids.filled.toDouble(), aq = asks.filled.toDouble();
+                    benchmark::DoNotOptimize((bq - aq) / (bq + aq));
+                    benchmark::DoNotOptimize((bids.vwap.toDouble() * aq + asks.vwap.toDouble() * bq) / (bq + aq));
+                  });
+}
+BENCHMARK(BM_TopAnalytics_Recompute)->Unit(benchmark::kNanosecond);
+
+// Repeated 200-level snapshots in which a few levels change each time
+static void runSnapshots(benchmark::State& state, auto&& apply)
+{
+  BookUpdatePool pool;
+  std::mt19937 rng(42);
+  std::vector<pool::Handle<BookUpdateEvent>> snaps;
+  for (int k = 0; k < 16; ++k)
+  {
+    auto h = pool.acquire();
+    assert(h);
+    (*h)->update.type = BookUpdateType::SNAPSHOT;
+    for (int i = 0; i < 200; ++i)
+    {
+      const double qty = 1.0 + i % 5 + (rng() % 50 == 0 ? 1.0 : 0.0);
+      (*h)->update.bids.push_back({Price::fromDouble(5000.0 - 0.1 * i), Quantity::fromDouble(qty)});
+      (*h)->update.asks.push_back({Price::fromDouble(5000.1 + 0.1 * i), Quantity::fromDouble(qty)});
+    }
+    snaps.push_back(std::move(*h));
+  }
+
+  size_t n = 0;
+  for (auto _ : state)
+  {
+    apply(*snaps[n++ & 15]);
+  }
+}
+
+static void BM_Snapshot_FullRebuild(benchmark::State& state)
+{
+  NLevelOrderBook<8192> book{Price::fromDouble(0.1)};
+  runSnapshots(state, [&](const BookUpdateEvent& ev)
+               { book.applyBookUpdate(ev);
+                 benchmark::DoNotOptimize(book.bestBid()); });
+}
+BENCHMARK(BM_Snapshot_FullRebuild)->Unit(benchmark::kNanosecond);
+
+static void BM_Snapshot_Diff(benchmark::State& state)
+{
+  NLevelOrderBook<8192> book{Price::fromDouble(0.1)};
+  size_t changes = 0;
+  runSnapshots(state, [&](const BookUpdateEvent& ev)
+               { book.applySnapshotDiff(ev.update, [&](Side, Price, Quantity) { ++changes; });
+                 benchmark::DoNotOptimize(book.bestBid()); });
+  state.counters["changes/snapshot"] = benchmark::Counter(static_cast<double>(changes), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Snapshot_Diff)->Unit(benchmark::kNanosecond);
+
 BENCHMARK_MAIN();
@@ -10,12 +10,10 @@
 #pragma once
 
 #include "demo/simple_components.h"
-#include "flox/book/nlevel_order_book.h"
 #include "flox/engine/abstract_subscriber.h"
 #include "flox/execution/bus/order_execution_bus.h"
 #include "flox/strategy/abstract_strategy.h"
 
-#include "flox/book/events/book_update_event.h"
 #include "flox/book/events/trade_event.h"
 
 namespace demo
@@ -34,7 +32,6 @@ class DemoStrategy : public IStrategy
   void stop() override;
 
   void onTrade(const TradeEvent& trade) override;
-  void onBookUpdate(const BookUpdateEvent& book) override;
 
  private:
   SimpleKillSwitch _killSwitch;
@@ -43,7 +40,6 @@ class DemoStrategy : public IStrategy
   SimpleOrderExecutor _executor;
 
   SymbolId _symbol;
-  NLevelOrderBook<> _book{Price::fromDouble(0.1)};
   OrderId _nextId{0};
 };
 
@@ -261,18 +261,11 @@ class SimpleOrderExecutor final : public IOrderExecutor
     FLOX_PROFILE_SCOPE("SimpleOrderExecutor::submitOrder");
 
     // accepted
-    OrderEvent ev{OrderEventStatus::ACCEPTED};
-    ev.order = order;
-    _bus.publish(ev);
+    _bus.emplace(OrderEventStatus::ACCEPTED, order);
 
     // simulate partial fill
     Quantity half = Quantity::fromRaw(order.quantity.raw() / 2);
-    ev = {};
-    ev.status = OrderEventStatus::PARTIALLY_FILLED;
-    ev.order = order;
-    ev.fillQty = half;
-
-    _bus.publish(ev);
+    _bus.emplace(OrderEventStatus::PARTIALLY_FILLED, order, Order{}, half);
 
     Order part = order;
     part.quantity = half;
@@ -283,18 +276,10 @@ class SimpleOrderExecutor final : public IOrderExecutor
     // simulate replace
     Order newOrder = order;
     newOrder.price += Price::fromDouble(0.1);
-    ev = {};
-    ev.status = OrderEventStatus::REPLACED;
-    ev.order = order;
-    ev.newOrder = newOrder;
-    _bus.publish(ev);
+    _bus.emplace(OrderEventStatus::REPLACED, order, newOrder);
 
     // final fill of remaining quantity
-    ev = {};
-    ev.status = OrderEventStatus::FILLED;
-    ev.order = newOrder;
-    ev.fillQty = order.quantity - half;
-    _bus.publish(ev);
+    _bus.emplace(OrderEventStatus::FILLED, newOrder, Order{}, order.quantity - half);
 
     Order rest = newOrder;
     rest.quantity = order.quantity - half;
@@ -14,11 +14,14 @@
 
 #include <chrono>
 #include <memory>
+#include <string>
 
 #include "flox/aggregator/bus/candle_bus.h"
 #include "flox/aggregator/candle_aggregator.h"
 #include "flox/book/bus/book_update_bus.h"
 #include "flox/book/bus/trade_bus.h"
+#include "flox/book/order_book_set.h"
+#include "flox/engine/symbol_registry.h"
 #include "flox/execution/bus/order_execution_bus.h"
 #include "flox/execution/execution_tracker_adapter.h"
 #include "flox/strategy/abstract_strategy.h"
@@ -26,14 +29,34 @@
 namespace demo
 {
 
-DemoBuilder::DemoBuilder(const EngineConfig& cfg) : _config(cfg) {}
+namespace
+{
+constexpr SymbolId NumSymbols = 8;
+}
+
+DemoBuilder::DemoBuilder(const EngineConfig& cfg) : _config(cfg)
+{
+  // Without a configured universe, trade the demo connectors' symbols; they quote in
+  // steps of 0.01
+  if (_config.exchanges.empty())
+  {
+    ExchangeConfig exchange{.name = "demo", .type = "demo", .symbols = {}};
+    for (SymbolId sym = 0; sym < NumSymbols; ++sym)
+    {
+      exchange.symbols.push_back(
+          {.symbol = "SYM" + std::to_string(sym), .tickSize = 0.01, .expectedDeviation = 0.0});
+    }
+    _config.exchanges.push_back(std::move(exchange));
+  }
+}
 
 std::unique_ptr<Engine> DemoBuilder::build()
 {
-  auto bookUpdateBus = std::make_unique<BookUpdateBus>();
-  auto tradeBus = std::make_unique<TradeBus>();
+  auto bookUpdateBus = std::make_unique<BookUpdateBus>(_config.eventBus);
+  auto tradeBus = std::make_unique<TradeBus>(_config.eventBus);
   auto execBus = std::make_unique<OrderExecutionBus>();
   auto candleBus = std::make_unique<CandleBus>();
+  candleBus->setWaitStrategy(WaitStrategy::park());
 
   auto execTracker = std::make_unique<ConsoleExecutionTracker>();
   auto trackerAdapter = std::make_unique<ExecutionTrackerAdapter>(1, execTracker.get());
@@ -67,12 +90,26 @@ std::unique_ptr<Engine> DemoBuilder::build()
   std::vector<std::shared_ptr<IStrategy>> strategies;
   std::vector<std::unique_ptr<ISubsystem>> subsystems;
 
-  for (SymbolId sym = 0; sym < 8; ++sym)
+  // One book per configured symbol, maintained once for the whole universe. Ids are
+  // handed out in config order, which is the order the connectors below use.
+  SymbolRegistry registry;
+  auto books = std::make_unique<OrderBookSet<>>(2, NumSymbols);
+  books->addSymbols(_config, registry);
+  bookUpdateBus->subscribe(books.get());
+  subsystems.push_back(std::move(books));
+
+  // All strategies share one consumer thread
+  IMarketDataSubscriber* strategyGroup = nullptr;
+  for (SymbolId sym = 0; sym < NumSymbols; ++sym)
   {
     auto strat = std::make_unique<DemoStrategy>(sym, *execBus);
 
-    bookUpdateBus->subscribe(strat.get());
-    tradeBus->subscribe(strat.get());
+    // Each strategy trades one symbol; the bus skips the rest before dispatch
+    tradeBus->subscribe(strat.get(), {.symbols = SymbolFilter{sym}, .group = strategyGroup});
+    if (!strategyGroup)
+    {
+      strategyGroup = strat.get();
+    }
 
     subsystems.push_back(std::move(strat));
   }
@@ -83,13 +83,4 @@ void DemoStrategy::onTrade(const TradeEvent& ev)
   _executor.submitOrder(order);
 }
 
-void DemoStrategy::onBookUpdate(const BookUpdateEvent& ev)
-{
-  if (ev.update.symbol == _symbol)
-  {
-    FLOX_PROFILE_SCOPE("DemoStrategy::onBookUpdate");
-    _book.applyBookUpdate(ev);
-  }
-}
-
 }  // namespace demo
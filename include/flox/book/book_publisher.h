@@ -0,0 +1,165 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/book_update.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/nlevel_order_book.h"
+#include "flox/common.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+#include "flox/util/base/time.h"
+#include "flox/util/concurrency/seqlock.h"
+#include "flox/util/memory/pool.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace flox
+{
+
+// Best bid and ask of one symbol; an empty side has zero quantity
+struct TopOfBook
+{
+  SymbolId symbol{};
+  Price bid{};
+  Quantity bidQty{};
+  Price ask{};
+  Quantity askQty{};
+  int64_t seq{0};  // `seq` of the last applied update
+  UnixNanos exchangeTsNs{0};
+
+  [[nodiscard]] bool hasBid() const noexcept { return !bidQty.isZero(); }
+  [[nodiscard]] bool hasAsk() const noexcept { return !askQty.isZero(); }
+};
+
+// Best `Depth` non-empty levels per side, best first
+template <size_t Depth>
+struct DepthSnapshot
+{
+  SymbolId symbol{};
+  uint32_t bidCount{0};
+  uint32_t askCount{0};
+  int64_t seq{0};
+  UnixNanos exchangeTsNs{0};
+  std::array<BookLevel, Depth> bids{};
+  std::array<BookLevel, Depth> asks{};
+
+  [[nodiscard]] std::span<const BookLevel> bidLevels() const noexcept { return {bids.data(), bidCount}; }
+  [[nodiscard]] std::span<const BookLevel> askLevels() const noexcept { return {asks.data(), askCount}; }
+};
+
+/**
+ * Maintains the book of one symbol on the bus thread and publishes its top of book and
+ * top-`Depth` levels for readers on any thread.
+ *
+ * Both views sit behind their own SeqLock: the bus thread never waits on readers, and a
+ * reader copies a consistent view without locking. Top of book is one cache line; the
+ * depth snapshot is larger, so readers that only need the touch do not pay for it.
+ * Subscribe one publisher per symbol to the BookUpdateBus instead of building the same
+ * book in every strategy.
+ */
+template <size_t Depth = 10, typename Book = NLevelOrderBook<>>
+class BookPublisher : public IMarketDataSubscriber
+{
+ public:
+  static constexpr size_t DEPTH = Depth;
+
+  // `bookArgs` construct the book, e.g. its tick size
+  template <typename... BookArgs>
+  BookPublisher(SubscriberId id, SymbolId symbol, BookArgs&&... bookArgs)
+      : _id(id), _symbol(symbol), _book(std::forward<BookArgs>(bookArgs)...)
+  {
+  }
+
+  SubscriberId id() const override { return _id; }
+
+  void onBookUpdate(const BookUpdateEvent& ev) override
+  {
+    if (ev.update.symbol != _symbol)
+    {
+      return;
+    }
+    _book.applyBookUpdate(ev);
+    publish(ev);
+  }
+
+  // A backlog is applied in full and published once
+  bool onBookUpdateBatch(std::span<const pool::Handle<BookUpdateEvent>> batch) override
+  {
+    const BookUpdateEvent* last = nullptr;
+    for (const auto& ev : batch)
+    {
+      if (ev->update.symbol == _symbol)
+      {
+        _book.applyBookUpdate(*ev);
+        last = ev.get();
+      }
+    }
+    if (last)
+    {
+      publish(*last);
+    }
+    return true;
+  }
+
+  // Any thread
+  [[nodiscard]] TopOfBook topOfBook() const noexcept { return _top.load(); }
+  [[nodiscard]] DepthSnapshot<Depth> depth() const noexcept { return _depth.load(); }
+  [[nodiscard]] bool tryTopOfBook(TopOfBook& out) const noexcept { return _top.tryLoad(out); }
+  [[nodiscard]] bool tryDepth(DepthSnapshot<Depth>& out) const noexcept { return _depth.tryLoad(out); }
+
+  // Updates published so far; readers can poll it to skip unchanged books
+  [[nodiscard]] uint64_t version() const noexcept { return _depth.version(); }
+
+  [[nodiscard]] SymbolId symbol() const noexcept { return _symbol; }
+
+  // Bus thread only
+  [[nodiscard]] const Book& book() const noexcept { return _book; }
+
+ private:
+  void publish(const BookUpdateEvent& ev)
+  {
+    DepthSnapshot<Depth> snap{};
+    snap.symbol = _symbol;
+    snap.seq = ev.seq;
+    snap.exchangeTsNs = ev.update.exchangeTsNs;
+    snap.bidCount = static_cast<uint32_t>(_book.bidDepth(snap.bids));
+    snap.askCount = static_cast<uint32_t>(_book.askDepth(snap.asks));
+
+    TopOfBook top{};
+    top.symbol = _symbol;
+    top.seq = snap.seq;
+    top.exchangeTsNs = snap.exchangeTsNs;
+    if (snap.bidCount > 0)
+    {
+      top.bid = snap.bids[0].price;
+      top.bidQty = snap.bids[0].quantity;
+    }
+    if (snap.askCount > 0)
+    {
+      top.ask = snap.asks[0].price;
+      top.askQty = snap.asks[0].quantity;
+    }
+
+    _top.store(top);
+    _depth.store(snap);
+  }
+
+  SubscriberId _id;
+  SymbolId _symbol;
+  Book _book;
+
+  SeqLock<TopOfBook> _top;
+  SeqLock<DepthSnapshot<Depth>> _depth;
+};
+
+}  // namespace flox
@@ -0,0 +1,382 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/events/book_update_event.h"
+#include "flox/common.h"
+#include "flox/util/base/time.h"
+#include "flox/util/memory/pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace flox
+{
+
+struct BookSequencerOptions
+{
+  size_t maxBuffered = 1024;        // deltas kept per stale symbol, at most its share of the pool
+  int64_t retryNs = 1'000'000'000;  // request again if no snapshot arrived within this time
+};
+
+/**
+ * Checks the `seq`/`prevSeq` chain of each symbol's book updates and recovers from gaps.
+ *
+ * A delta continues the chain when its `prevSeq` (or `seq - 1` if the feed leaves
+ * `prevSeq` at 0) is the `seq` of the last applied update. On a gap the symbol is marked
+ * stale, a snapshot is requested, and the following deltas are copied into a pooled
+ * buffer instead of being applied. Snapshots and deltas at or below the last applied
+ * `seq` of a synced symbol are duplicates and are dropped. When the snapshot arrives it is applied and the
+ * buffered deltas newer than it are replayed; if they do not continue its chain, another
+ * snapshot is requested. Updates with `seq == 0` are not sequenced and pass through.
+ *
+ * State is per symbol and nothing blocks, so a gap on one symbol does not hold up the
+ * others. Each symbol buffers at most its share of the shared pool, so one symbol that
+ * never gets a snapshot cannot starve the recovery of the rest. process() runs on the
+ * bus thread; isStale() and stats() may be read from any.
+ */
+class BookSequencer
+{
+ public:
+  // Called on the bus thread; should only queue the request
+  using SnapshotRequest = std::move_only_function<void(SymbolId)>;
+
+  using Options = BookSequencerOptions;
+
+  struct Stats
+  {
+    uint64_t gaps{0};              // chains found broken, including by a failed replay
+    uint64_t recoveries{0};        // stale symbols brought back by a snapshot
+    uint64_t snapshotRequests{0};  // including retries
+    uint64_t buffered{0};          // deltas held while stale
+    uint64_t replayed{0};          // buffered deltas applied after a snapshot
+    uint64_t discarded{0};         // duplicates
+    uint64_t overflowed{0};        // deltas dropped from, or not taken into, a full buffer
+    uint64_t staleSymbols{0};      // symbols stale right now
+    int64_t lastRecoveryNs{0};     // from the gap to the replayed snapshot
+    int64_t maxRecoveryNs{0};
+    int64_t totalRecoveryNs{0};
+  };
+
+  // Events shared by the buffers of all symbols
+  static constexpr size_t BufferPoolSize = 1023;
+
+  BookSequencer(size_t maxSymbols, SnapshotRequest request, Options options = {})
+      : _maxSymbols(maxSymbols),
+        _request(std::move(request)),
+        _options(options),
+        _budget(std::max<size_t>(1, std::min(options.maxBuffered, BufferPoolSize / std::max<size_t>(1, maxSymbols)))),
+        _pool(std::make_unique<pool::Pool<BookUpdateEvent, BufferPoolSize>>()),
+        _states(std::make_unique<SymbolState[]>(maxSymbols))
+  {
+    for (size_t i = 0; i < maxSymbols; ++i)
+    {
+      _states[i].buffer.slots.resize(_budget);
+    }
+  }
+
+  // Feeds one update; apply(const BookUpdateEvent&) is called for every update that
+  // should reach the book, in order
+  template <typename Apply>
+  void process(const BookUpdateEvent& ev, Apply&& apply)
+  {
+    const SymbolId symbol = ev.update.symbol;
+    if (ev.seq == 0 || symbol >= _maxSymbols)
+    {
+      apply(ev);
+      return;
+    }
+
+    SymbolState& s = _states[symbol];
+    if (ev.update.type == BookUpdateType::SNAPSHOT)
+    {
+      if (s.stale.load(std::memory_order_relaxed))
+      {
+        recover(symbol, s, ev, apply);
+        return;
+      }
+      if (s.synced && ev.seq <= s.lastSeq)
+      {
+        // Late or repeated: applying it would rewind the book and the chain
+        bump(_counters.discarded);
+        return;
+      }
+      apply(ev);
+      s.lastSeq = ev.seq;
+      s.synced = true;
+      return;
+    }
+
+    if (s.stale.load(std::memory_order_relaxed))
+    {
+      const int64_t now = nowNsMonotonic();
+      if (now - s.requestedNs >= _options.retryNs)
+      {
+        requestSnapshot(symbol, s, now);
+      }
+      hold(s, ev);
+      return;
+    }
+    if (s.synced && ev.seq <= s.lastSeq)
+    {
+      bump(_counters.discarded);
+      return;
+    }
+    if (!s.synced || predecessor(ev) != s.lastSeq)
+    {
+      // No snapshot yet, or a gap: the book cannot be trusted until one arrives
+      markStale(symbol, s);
+      hold(s, ev);
+      return;
+    }
+    apply(ev);
+    s.lastSeq = ev.seq;
+  }
+
+  [[nodiscard]] bool isStale(SymbolId symbol) const noexcept
+  {
+    return symbol < _maxSymbols && _states[symbol].stale.load(std::memory_order_relaxed);
+  }
+
+  // Forgets the chain of `symbol`, e.g. after its book was replaced; bus thread only
+  void reset(SymbolId symbol)
+  {
+    if (symbol >= _maxSymbols)
+    {
+      return;
+    }
+    SymbolState& s = _states[symbol];
+    if (s.stale.load(std::memory_order_relaxed))
+    {
+      s.stale.store(false, std::memory_order_relaxed);
+      _counters.staleSymbols.fetch_sub(1, std::memory_order_relaxed);
+    }
+    s.buffer.clear();
+    s.synced = false;
+    s.lastSeq = 0;
+  }
+
+  Stats stats() const
+  {
+    const auto& c = _counters;
+    return Stats{
+        .gaps = c.gaps.load(std::memory_order_relaxed),
+        .recoveries = c.recoveries.load(std::memory_order_relaxed),
+        .snapshotRequests = c.snapshotRequests.load(std::memory_order_relaxed),
+        .buffered = c.buffered.load(std::memory_order_relaxed),
+        .replayed = c.replayed.load(std::memory_order_relaxed),
+        .discarded = c.discarded.load(std::memory_order_relaxed),
+        .overflowed = c.overflowed.load(std::memory_order_relaxed),
+        .staleSymbols = c.staleSymbols.load(std::memory_order_relaxed),
+        .lastRecoveryNs = c.lastRecoveryNs.load(std::memory_order_relaxed),
+        .maxRecoveryNs = c.maxRecoveryNs.load(std::memory_order_relaxed),
+        .totalRecoveryNs = c.totalRecoveryNs.load(std::memory_order_relaxed),
+    };
+  }
+
+ private:
+  using Held = pool::Handle<BookUpdateEvent>;
+
+  // Fixed-capacity FIFO of buffered deltas; dropping the oldest is O(1) on a burst
+  struct DeltaRing
+  {
+    std::vector<std::optional<Held>> slots;
+    size_t head{0};
+    size_t count{0};
+
+    size_t size() const noexcept { return count; }
+    bool full() const noexcept { return count == slots.size(); }
+
+    const BookUpdateEvent& operator[](size_t i) const noexcept { return **slots[wrap(head + i)]; }
+
+    void push(Held h)
+    {
+      slots[wrap(head + count)].emplace(std::move(h));
+      ++count;
+    }
+
+    void popFront(size_t n = 1) noexcept
+    {
+      for (; n > 0; --n, --count)
+      {
+        slots[head].reset();
+        head = wrap(head + 1);
+      }
+    }
+
+    void clear() noexcept
+    {
+      popFront(count);
+      head = 0;
+    }
+
+    size_t wrap(size_t i) const noexcept { return i < slots.size() ? i : i - slots.size(); }
+  };
+
+  struct SymbolState
+  {
+    std::atomic<bool> stale{false};
+    bool synced{false};  // lastSeq is known
+    int64_t lastSeq{0};
+    int64_t staleSinceNs{0};
+    int64_t requestedNs{0};
+    DeltaRing buffer;
+  };
+
+  // Written by the bus thread only; stats() reads them from any thread
+  struct alignas(64) Counters
+  {
+    std::atomic<uint64_t> gaps{0};
+    std::atomic<uint64_t> recoveries{0};
+    std::atomic<uint64_t> snapshotRequests{0};
+    std::atomic<uint64_t> buffered{0};
+    std::atomic<uint64_t> replayed{0};
+    std::atomic<uint64_t> discarded{0};
+    std::atomic<uint64_t> overflowed{0};
+    std::atomic<uint64_t> staleSymbols{0};
+    std::atomic<int64_t> lastRecoveryNs{0};
+    std::atomic<int64_t> maxRecoveryNs{0};
+    std::atomic<int64_t> totalRecoveryNs{0};
+  };
+
+  template <typename T>
+  static void bump(std::atomic<T>& c, T by = 1) noexcept
+  {
+    c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+  }
+
+  static int64_t predecessor(const BookUpdateEvent& ev) noexcept
+  {
+    return ev.prevSeq != 0 ? ev.prevSeq : ev.seq - 1;
+  }
+
+  void markStale(SymbolId symbol, SymbolState& s)
+  {
+    s.stale.store(true, std::memory_order_relaxed);
+    s.staleSinceNs = nowNsMonotonic();
+    bump(_counters.gaps);
+    bump(_counters.staleSymbols);
+    requestSnapshot(symbol, s, s.staleSinceNs);
+  }
+
+  void requestSnapshot(SymbolId symbol, SymbolState& s, int64_t now)
+  {
+    s.requestedNs = now;
+    bump(_counters.snapshotRequests);
+    if (_request)
+    {
+      _request(symbol);
+    }
+  }
+
+  // Copies a delta into the buffer of a stale symbol
+  void hold(SymbolState& s, const BookUpdateEvent& ev)
+  {
+    if (s.buffer.full())
+    {
+      // The snapshot will most likely be newer than the oldest deltas anyway
+      s.buffer.popFront();
+      bump(_counters.overflowed);
+    }
+
+    auto h = _pool->acquire();
+    if (!h)
+    {
+      // Only with more symbols than pooled events; the replay detects the hole and asks again
+      bump(_counters.overflowed);
+      return;
+    }
+    BookUpdateEvent& copy = **h;
+    copy.update.symbol = ev.update.symbol;
+    copy.update.instrument = ev.update.instrument;
+    copy.update.type = ev.update.type;
+    copy.update.bids.assign(ev.update.bids.begin(), ev.update.bids.end());
+    copy.update.asks.assign(ev.update.asks.begin(), ev.update.asks.end());
+    copy.update.exchangeTsNs = ev.update.exchangeTsNs;
+    copy.update.systemTsNs = ev.update.systemTsNs;
+    copy.update.strike = ev.update.strike;
+    copy.update.expiry = ev.update.expiry;
+    copy.update.optionType = ev.update.optionType;
+    copy.seq = ev.seq;
+    copy.prevSeq = ev.prevSeq;
+    copy.tickSequence = ev.tickSequence;
+    copy.recvNs = ev.recvNs;
+    copy.publishTsNs = ev.publishTsNs;
+    s.buffer.push(std::move(*h));
+    bump(_counters.buffered);
+  }
+
+  template <typename Apply>
+  void recover(SymbolId symbol, SymbolState& s, const BookUpdateEvent& snapshot, Apply& apply)
+  {
+    apply(snapshot);
+    s.lastSeq = snapshot.seq;
+    s.synced = true;
+
+    size_t used = 0;
+    uint64_t replayed = 0;
+    for (; used < s.buffer.size(); ++used)
+    {
+      const BookUpdateEvent& delta = s.buffer[used];
+      if (delta.seq <= s.lastSeq)
+      {
+        continue;  // already in the snapshot
+      }
+      if (predecessor(delta) != s.lastSeq)
+      {
+        break;
+      }
+      apply(delta);
+      s.lastSeq = delta.seq;
+      ++replayed;
+    }
+    bump(_counters.replayed, replayed);
+
+    const int64_t now = nowNsMonotonic();
+    if (used < s.buffer.size())
+    {
+      // Deltas between the snapshot and the buffer are missing; keep the rest for a
+      // newer snapshot
+      s.buffer.popFront(used);
+      bump(_counters.gaps);
+      requestSnapshot(symbol, s, now);
+      return;
+    }
+    s.buffer.clear();
+
+    const int64_t took = now - s.staleSinceNs;
+    s.stale.store(false, std::memory_order_relaxed);
+    _counters.staleSymbols.fetch_sub(1, std::memory_order_relaxed);
+    bump(_counters.recoveries);
+    bump(_counters.totalRecoveryNs, took);
+    _counters.lastRecoveryNs.store(took, std::memory_order_relaxed);
+    if (took > _counters.maxRecoveryNs.load(std::memory_order_relaxed))
+    {
+      _counters.maxRecoveryNs.store(took, std::memory_order_relaxed);
+    }
+  }
+
+  size_t _maxSymbols;
+  SnapshotRequest _request;
+  Options _options;
+  size_t _budget;  // deltas buffered per stale symbol
+  // Outlives the buffers, which hand their events back to it
+  std::unique_ptr<pool::Pool<BookUpdateEvent, BufferPoolSize>> _pool;
+  std::unique_ptr<SymbolState[]> _states;
+  Counters _counters;
+};
+
+}  // namespace flox
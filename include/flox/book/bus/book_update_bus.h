@@ -10,6 +10,7 @@
 #pragma once
 
 #include "flox/book/events/book_update_event.h"
+#include "flox/util/eventing/conflating_event_bus.h"
 #include "flox/util/eventing/event_bus.h"
 #include "flox/util/memory/pool.h"
 
@@ -18,6 +19,9 @@ namespace flox
 
 using BookUpdateBus = EventBus<pool::Handle<BookUpdateEvent>>;
 
+// Latest snapshot per symbol, for consumers that only need current state
+using ConflatingBookUpdateBus = ConflatingEventBus<pool::Handle<BookUpdateEvent>>;
+
 /**
  * @brief Create a BookUpdateBus with optimal performance configuration
  * @param enablePerformanceOptimizations Enable CPU frequency scaling optimizations
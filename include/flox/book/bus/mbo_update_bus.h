@@ -0,0 +1,21 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/events/mbo_update_event.h"
+#include "flox/util/eventing/event_bus.h"
+
+namespace flox
+{
+
+// Order-level messages are small and trivially copyable, so they travel by value
+using MboUpdateBus = EventBus<MboUpdateEvent>;
+
+}  // namespace flox
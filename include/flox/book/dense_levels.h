@@ -0,0 +1,168 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/common.h"
+#include "flox/util/base/occupancy_bitmap.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace flox
+{
+
+/**
+ * One side of a dense price window: N quantities indexed by distance from the window's
+ * first tick, stored as a ring with an occupancy bitmap.
+ *
+ * Indices are logical; rotate() moves the window over the ring without copying levels.
+ * next()/prev() skip empty stretches through the bitmap.
+ */
+template <size_t N>
+class DenseLevels
+{
+ public:
+  static constexpr size_t SIZE = N;
+  static constexpr size_t NPOS = N;
+
+  [[nodiscard]] Quantity get(size_t i) const noexcept { return _qty[slot(i)]; }
+
+  // Returns the previous quantity
+  Quantity set(size_t i, Quantity q) noexcept
+  {
+    const size_t s = slot(i);
+    const Quantity old = _qty[s];
+    _qty[s] = q;
+    if (q.isZero())
+    {
+      _bits.reset(s);
+    }
+    else
+    {
+      _bits.set(s);
+    }
+    return old;
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return !_bits.any(); }
+
+  // Number of occupied levels
+  [[nodiscard]] size_t count() const noexcept { return _bits.count(); }
+
+  // First occupied index at or after `from`, or NPOS
+  [[nodiscard]] size_t next(size_t from) const noexcept
+  {
+    if (from >= N)
+    {
+      return NPOS;
+    }
+    const size_t s = slot(from);
+    if (s >= _origin)
+    {
+      const size_t found = _bits.next(s);
+      if (found < N)
+      {
+        return found - _origin;
+      }
+      const size_t wrapped = _bits.next(0);
+      return wrapped < _origin ? wrapped + N - _origin : NPOS;
+    }
+    const size_t found = _bits.next(s);
+    return found < _origin ? found + N - _origin : NPOS;
+  }
+
+  // Last occupied index at or before `from` (clamped to N - 1), or NPOS
+  [[nodiscard]] size_t prev(size_t from) const noexcept
+  {
+    const size_t s = slot(from < N ? from : N - 1);
+    if (s < _origin)
+    {
+      const size_t found = _bits.prev(s);
+      if (found < N)
+      {
+        return found + N - _origin;
+      }
+      const size_t wrapped = _bits.prev(N - 1);
+      return wrapped < N && wrapped >= _origin ? wrapped - _origin : NPOS;
+    }
+    const size_t found = _bits.prev(s);
+    return found < N && found >= _origin ? found - _origin : NPOS;
+  }
+
+  // Levels from index `i` upward that are contiguous in memory, up to the end of the ring
+  // or of the window
+  [[nodiscard]] std::span<const Quantity> runFrom(size_t i) const noexcept
+  {
+    const size_t s = slot(i);
+    return {_qty.data() + s, std::min(N - s, N - i)};
+  }
+
+  // Levels up to and including index `i` that are contiguous in memory, down to the start
+  // of the ring or of the window
+  [[nodiscard]] std::span<const Quantity> runTo(size_t i) const noexcept
+  {
+    const size_t s = slot(i);
+    const size_t len = std::min(s, i) + 1;
+    return {_qty.data() + s + 1 - len, len};
+  }
+
+  // Empties the occupied levels in [from, to), calling f(index, quantity) for each
+  template <typename F>
+  void take(size_t from, size_t to, F&& f)
+  {
+    for (size_t i = next(from); i < to; i = next(i + 1))
+    {
+      const size_t s = slot(i);
+      f(i, _qty[s]);
+      _qty[s] = {};
+      _bits.reset(s);
+    }
+  }
+
+  // Empties the occupied levels only, instead of the whole ring
+  void clear() noexcept
+  {
+    _bits.forEach(0, N - 1, [&](size_t s)
+                  { _qty[s] = {}; });
+    _bits.clear();
+  }
+
+  // Re-index so that the current index `shift` becomes index 0. Levels keep their slots;
+  // the caller empties those that no longer belong to the window first.
+  void rotate(int64_t shift) noexcept
+  {
+    const int64_t n = static_cast<int64_t>(N);
+    _origin = static_cast<size_t>((static_cast<int64_t>(_origin) + shift % n + n) % n);
+  }
+
+  // Full reset, including the ring origin
+  void reset() noexcept
+  {
+    _qty.fill({});
+    _bits.clear();
+    _origin = 0;
+  }
+
+ private:
+  [[nodiscard]] size_t slot(size_t i) const noexcept
+  {
+    const size_t s = i + _origin;
+    return s >= N ? s - N : s;
+  }
+
+  alignas(64) std::array<Quantity, N> _qty{};
+  OccupancyBitmap<N> _bits{};
+  size_t _origin{0};  // slot of index 0
+};
+
+}  // namespace flox
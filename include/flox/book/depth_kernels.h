@@ -0,0 +1,283 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/common.h"
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace flox
+{
+
+// Exact result of walking one side of a book
+struct DepthFill
+{
+  Quantity filled{};
+  Volume notional{};  // sum of price * quantity over the filled part, truncated once
+  Price vwap{};       // notional / filled, truncated once; zero if nothing was filled
+  Price worst{};      // price of the last level touched
+};
+
+}  // namespace flox
+
+namespace flox::depth
+{
+
+static_assert(sizeof(Quantity) == sizeof(int64_t), "kernels read quantities as raw int64 lanes");
+
+using i128 = __int128_t;
+
+// Levels summed per weightedSum() call; keeps the 64-bit lanes from overflowing for
+// level quantities below LANE_LIMIT
+inline constexpr size_t BLOCK_LEVELS = 64;
+
+// Level quantities below this many raw units (2^50, about 10^9 units) can be summed and
+// index-weighted over a block in 64-bit lanes; larger ones go through the i128 scalar path
+inline constexpr int64_t LANE_LIMIT = int64_t{1} << 50;
+
+inline int64_t sumScalar(const Quantity* q, size_t n) noexcept
+{
+  int64_t s = 0;
+  for (size_t k = 0; k < n; ++k)
+  {
+    s += q[k].raw();
+  }
+  return s;
+}
+
+// Sum of k * q[k] for k in [0, n)
+inline int64_t weightedSumScalar(const Quantity* q, size_t n) noexcept
+{
+  int64_t s = 0;
+  for (size_t k = 0; k < n; ++k)
+  {
+    s += static_cast<int64_t>(k) * q[k].raw();
+  }
+  return s;
+}
+
+// Sum of the raw quantities in q[0, n)
+inline int64_t sum(const Quantity* q, size_t n) noexcept
+{
+  const auto* p = reinterpret_cast<const int64_t*>(q);
+  size_t k = 0;
+  int64_t s = 0;
+
+#if defined(__AVX512F__)
+  __m512i acc0 = _mm512_setzero_si512();
+  __m512i acc1 = _mm512_setzero_si512();
+  for (; k + 16 <= n; k += 16)
+  {
+    acc0 = _mm512_add_epi64(acc0, _mm512_loadu_si512(p + k));
+    acc1 = _mm512_add_epi64(acc1, _mm512_loadu_si512(p + k + 8));
+  }
+  s = _mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1));
+#elif defined(__AVX2__)
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  for (; k + 8 <= n; k += 8)
+  {
+    acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k)));
+    acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k + 4)));
+  }
+  alignas(32) int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+  s = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+  for (; k < n; ++k)
+  {
+    s += p[k];
+  }
+  return s;
+}
+
+// True if every raw quantity in q[0, n) is in [0, LANE_LIMIT), so sum() and weightedSum()
+// over the block are exact
+inline bool fitsLanes(const Quantity* q, size_t n) noexcept
+{
+  const auto* p = reinterpret_cast<const int64_t*>(q);
+  size_t k = 0;
+  uint64_t bits = 0;
+
+#if defined(__AVX512F__)
+  __m512i acc = _mm512_setzero_si512();
+  for (; k + 8 <= n; k += 8)
+  {
+    acc = _mm512_or_si512(acc, _mm512_loadu_si512(p + k));
+  }
+  bits = static_cast<uint64_t>(_mm512_reduce_or_epi64(acc));
+#elif defined(__AVX2__)
+  __m256i acc = _mm256_setzero_si256();
+  for (; k + 4 <= n; k += 4)
+  {
+    acc = _mm256_or_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k)));
+  }
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  bits = lanes[0] | lanes[1] | lanes[2] | lanes[3];
+#endif
+
+  for (; k < n; ++k)
+  {
+    bits |= static_cast<uint64_t>(p[k]);
+  }
+  // A negative quantity sets the top bit and fails as well
+  return bits < static_cast<uint64_t>(LANE_LIMIT);
+}
+
+// Sum of k * q[k] for k in [0, n), n <= BLOCK_LEVELS
+inline int64_t weightedSum(const Quantity* q, size_t n) noexcept
+{
+  assert(n <= BLOCK_LEVELS);
+  const auto* p = reinterpret_cast<const int64_t*>(q);
+  size_t k = 0;
+  int64_t s = 0;
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+  __m512i idx = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m512i step = _mm512_set1_epi64(8);
+  __m512i acc = _mm512_setzero_si512();
+  for (; k + 8 <= n; k += 8)
+  {
+    acc = _mm512_add_epi64(acc, _mm512_mullo_epi64(idx, _mm512_loadu_si512(p + k)));
+    idx = _mm512_add_epi64(idx, step);
+  }
+  s = _mm512_reduce_add_epi64(acc);
+#elif defined(__AVX2__)
+  // No 64-bit multiply in AVX2: the index fits in 32 bits, so multiply it by the low and
+  // high halves of each (non-negative) quantity separately
+  __m256i idx = _mm256_setr_epi64x(0, 1, 2, 3);
+  const __m256i step = _mm256_set1_epi64x(4);
+  __m256i acc = _mm256_setzero_si256();
+  for (; k + 4 <= n; k += 4)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k));
+    const __m256i lo = _mm256_mul_epu32(v, idx);
+    const __m256i hi = _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(v, 32), idx), 32);
+    acc = _mm256_add_epi64(acc, _mm256_add_epi64(lo, hi));
+    idx = _mm256_add_epi64(idx, step);
+  }
+  alignas(32) int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  s = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+  for (; k < n; ++k)
+  {
+    s += static_cast<int64_t>(k) * p[k];
+  }
+  return s;
+}
+
+// Number of non-empty levels in q[0, n)
+inline size_t occupied(const Quantity* q, size_t n) noexcept
+{
+  const auto* p = reinterpret_cast<const int64_t*>(q);
+  size_t k = 0;
+  size_t c = 0;
+
+#if defined(__AVX512F__)
+  const __m512i zero = _mm512_setzero_si512();
+  for (; k + 8 <= n; k += 8)
+  {
+    c += static_cast<size_t>(std::popcount(static_cast<unsigned>(_mm512_cmpneq_epi64_mask(_mm512_loadu_si512(p + k), zero))));
+  }
+#elif defined(__AVX2__)
+  const __m256i zero = _mm256_setzero_si256();
+  for (; k + 4 <= n; k += 4)
+  {
+    const __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k)), zero);
+    c += 4 - static_cast<size_t>(std::popcount(static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(eq)))));
+  }
+#endif
+
+  for (; k < n; ++k)
+  {
+    c += p[k] != 0;
+  }
+  return c;
+}
+
+// Writes the running sum of q[0, n), starting from `carry`, to out[0, n); returns the total.
+// Each output depends on the previous one, so this stays a scalar loop.
+inline int64_t prefixSum(const Quantity* q, size_t n, int64_t carry, Quantity* out) noexcept
+{
+  for (size_t k = 0; k < n; ++k)
+  {
+    carry += q[k].raw();
+    out[k] = Quantity::fromRaw(carry);
+  }
+  return carry;
+}
+
+// Accumulates the exact fill of one side; prices are tick * tickSize
+class FillAccumulator
+{
+ public:
+  FillAccumulator(int64_t need, Price tickSize) : _rem(need), _tickSize(tickSize.raw()) {}
+
+  [[nodiscard]] int64_t remaining() const noexcept { return _rem; }
+
+  // A whole block q[0, n) whose first level sits at `firstTick`; total is sum(q, n). The
+  // block must pass fitsLanes().
+  void takeBlock(const Quantity* q, size_t n, int64_t firstTick, int64_t total, int64_t lastTick) noexcept
+  {
+    _filled += total;
+    _rem -= total;
+    _tickQty += static_cast<i128>(firstTick) * total + weightedSum(q, n);
+    _lastTick = lastTick;
+  }
+
+  // One level; returns false once the requested quantity is filled
+  bool take(int64_t tick, int64_t qty) noexcept
+  {
+    if (qty > 0)
+    {
+      const int64_t fill = qty < _rem ? qty : _rem;
+      _filled += fill;
+      _rem -= fill;
+      _tickQty += static_cast<i128>(tick) * fill;
+      _lastTick = tick;
+    }
+    return _rem > 0;
+  }
+
+  [[nodiscard]] DepthFill result() const noexcept
+  {
+    DepthFill out{};
+    if (_filled == 0)
+    {
+      return out;
+    }
+    const i128 notionalRaw = _tickQty * _tickSize;  // raw price * raw quantity
+    out.filled = Quantity::fromRaw(_filled);
+    out.notional = Volume::fromRaw(static_cast<int64_t>(notionalRaw / Quantity::Scale));
+    out.vwap = Price::fromRaw(static_cast<int64_t>(notionalRaw / _filled));
+    out.worst = Price::fromRaw(_lastTick * _tickSize);
+    return out;
+  }
+
+ private:
+  int64_t _rem;
+  int64_t _tickSize;
+  int64_t _filled{0};
+  int64_t _lastTick{0};
+  i128 _tickQty{0};  // sum of tick * raw quantity
+};
+
+}  // namespace flox::depth
@@ -0,0 +1,33 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/mbo_update.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+#include "flox/util/base/time.h"
+
+namespace flox
+{
+
+struct MboUpdateEvent
+{
+  using Listener = IMarketDataSubscriber;
+
+  MboUpdate update{};
+
+  int64_t seq = 0;
+
+  uint64_t tickSequence = 0;  // internal, set by bus
+
+  MonoNanos recvNs{0};
+  MonoNanos publishTsNs{0};
+};
+
+}  // namespace flox
@@ -0,0 +1,355 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/abstract_order_book.h"
+#include "flox/book/dense_levels.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/common.h"
+#include "flox/util/base/math.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace flox
+{
+
+/**
+ * Order book with a dense hot window around the touch and a sorted overflow tier for
+ * every level outside it.
+ *
+ * Updates inside the window cost the same as in NLevelOrderBook. Far levels live in a
+ * flat vector per side, sorted by tick, so a book can span any price range without
+ * dropping levels or reserving memory for the whole range. When the touch drifts toward
+ * the edge of the window, the window recenters: levels that scroll out move to the
+ * overflow tier and overflow levels that scroll in move to the window.
+ */
+template <size_t HotLevels = 1024>
+class HybridOrderBook : public IOrderBook
+{
+ public:
+  static constexpr size_t HOT_LEVELS = HotLevels;
+
+  // `farReserve` levels per side are reserved up front for the overflow tier
+  explicit HybridOrderBook(Price tickSize, size_t farReserve = 1024)
+      : _tickSize(tickSize)
+  {
+    _tickSizeDiv = math::make_fastdiv64((uint64_t)_tickSize.raw(), 1);
+    _farBids.reserve(farReserve);
+    _farAsks.reserve(farReserve);
+    _moved.reserve(HotLevels);
+  }
+
+  void applyBookUpdate(const BookUpdateEvent& ev) override
+  {
+    const auto& up = ev.update;
+
+    if (up.type == BookUpdateType::SNAPSHOT)
+    {
+      clear();
+
+      // The book is empty, so the window can be placed around the new touch for free
+      int64_t bid = std::numeric_limits<int64_t>::min();
+      int64_t ask = std::numeric_limits<int64_t>::max();
+      for (const auto& [p, q] : up.bids)
+      {
+        if (!q.isZero())
+        {
+          bid = std::max(bid, ticks(p));
+        }
+      }
+      for (const auto& [p, q] : up.asks)
+      {
+        if (!q.isZero())
+        {
+          ask = std::min(ask, ticks(p));
+        }
+      }
+      if (const auto center = touchCenter(bid, ask))
+      {
+        _base = *center - static_cast<int64_t>(HotLevels / 2);
+      }
+    }
+
+    for (const auto& [p, q] : up.bids)
+    {
+      setLevel(_hotBids, _farBids, ticks(p), q);
+    }
+    for (const auto& [p, q] : up.asks)
+    {
+      setLevel(_hotAsks, _farAsks, ticks(p), q);
+    }
+
+    followTouch();
+  }
+
+  [[nodiscard]] std::optional<Price> bestBid() const override
+  {
+    const int64_t t = bestBidTick();
+    if (t == std::numeric_limits<int64_t>::min())
+    {
+      return std::nullopt;
+    }
+    return Price::fromRaw(_tickSize.raw() * t);
+  }
+
+  [[nodiscard]] std::optional<Price> bestAsk() const override
+  {
+    const int64_t t = bestAskTick();
+    if (t == std::numeric_limits<int64_t>::max())
+    {
+      return std::nullopt;
+    }
+    return Price::fromRaw(_tickSize.raw() * t);
+  }
+
+  [[nodiscard]] Quantity bidAtPrice(Price p) const override { return levelAt(_hotBids, _farBids, ticks(p)); }
+  [[nodiscard]] Quantity askAtPrice(Price p) const override { return levelAt(_hotAsks, _farAsks, ticks(p)); }
+
+  // Walks asks upward from the best one; returns {filled quantity, notional}
+  [[nodiscard]] std::pair<double, double> consumeAsks(double needQtyBase) const noexcept
+  {
+    Consumer c{needQtyBase, _tickSize.toDouble()};
+
+    // Far levels below the window, the window, then far levels above it
+    auto it = _farAsks.begin();
+    for (; it != _farAsks.end() && it->first < _base && c.take(it->first, it->second); ++it)
+    {
+    }
+    if (c.rem > math::EPS_QTY)
+    {
+      for (size_t i = _hotAsks.next(0); i < HotLevels && c.take(_base + static_cast<int64_t>(i), _hotAsks.get(i));
+           i = _hotAsks.next(i + 1))
+      {
+      }
+    }
+    for (; c.rem > math::EPS_QTY && it != _farAsks.end() && c.take(it->first, it->second); ++it)
+    {
+    }
+    return {needQtyBase - c.rem, c.notional};
+  }
+
+  // Walks bids downward from the best one; returns {filled quantity, notional}
+  [[nodiscard]] std::pair<double, double> consumeBids(double needQtyBase) const noexcept
+  {
+    Consumer c{needQtyBase, _tickSize.toDouble()};
+    const int64_t hotEnd = _base + static_cast<int64_t>(HotLevels);
+
+    // Far levels above the window, the window, then far levels below it
+    auto it = _farBids.rbegin();
+    for (; it != _farBids.rend() && it->first >= hotEnd && c.take(it->first, it->second); ++it)
+    {
+    }
+    if (c.rem > math::EPS_QTY)
+    {
+      for (size_t i = _hotBids.prev(HotLevels - 1);
+           i < HotLevels && c.take(_base + static_cast<int64_t>(i), _hotBids.get(i));
+           i = i == 0 ? HotLevels : _hotBids.prev(i - 1))
+      {
+      }
+    }
+    for (; c.rem > math::EPS_QTY && it != _farBids.rend() && c.take(it->first, it->second); ++it)
+    {
+    }
+    return {needQtyBase - c.rem, c.notional};
+  }
+
+  [[nodiscard]] Price tickSize() const noexcept { return _tickSize; }
+
+  // Tick of the first hot level
+  [[nodiscard]] int64_t windowBase() const noexcept { return _base; }
+
+  // Levels currently held in the overflow tier, both sides
+  [[nodiscard]] size_t farLevels() const noexcept { return _farBids.size() + _farAsks.size(); }
+
+  void clear() noexcept
+  {
+    _hotBids.clear();
+    _hotAsks.clear();
+    _farBids.clear();
+    _farAsks.clear();
+  }
+
+ private:
+  using FarLevel = std::pair<int64_t, Quantity>;  // tick, quantity; sorted by tick
+  using FarLevels = std::vector<FarLevel>;
+  using Hot = DenseLevels<HotLevels>;
+
+  struct Consumer
+  {
+    double rem;
+    double tick;
+    double notional{0.0};
+
+    // Returns false once the requested quantity is filled
+    bool take(int64_t t, Quantity level)
+    {
+      const double q = level.toDouble();
+      if (q > 0.0)
+      {
+        const double fill = q < rem ? q : rem;
+        notional += fill * tick * static_cast<double>(t);
+        rem -= fill;
+      }
+      return rem > math::EPS_QTY;
+    }
+  };
+
+  static bool tickLess(const FarLevel& level, int64_t t) { return level.first < t; }
+
+  [[nodiscard]] int64_t ticks(Price p) const noexcept { return math::sdiv_round_nearest(p.raw(), _tickSizeDiv); }
+
+  [[nodiscard]] bool inWindow(int64_t t) const noexcept
+  {
+    return static_cast<uint64_t>(t - _base) < static_cast<uint64_t>(HotLevels);
+  }
+
+  static std::optional<int64_t> touchCenter(int64_t bid, int64_t ask) noexcept
+  {
+    const bool hasBid = bid != std::numeric_limits<int64_t>::min();
+    const bool hasAsk = ask != std::numeric_limits<int64_t>::max();
+    if (hasBid && hasAsk)
+    {
+      return bid + (ask - bid) / 2;
+    }
+    if (hasBid || hasAsk)
+    {
+      return hasBid ? bid : ask;
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] int64_t bestBidTick() const noexcept
+  {
+    int64_t best = _farBids.empty() ? std::numeric_limits<int64_t>::min() : _farBids.back().first;
+    const size_t i = _hotBids.prev(HotLevels - 1);
+    if (i < HotLevels)
+    {
+      best = std::max(best, _base + static_cast<int64_t>(i));
+    }
+    return best;
+  }
+
+  [[nodiscard]] int64_t bestAskTick() const noexcept
+  {
+    int64_t best = _farAsks.empty() ? std::numeric_limits<int64_t>::max() : _farAsks.front().first;
+    const size_t i = _hotAsks.next(0);
+    if (i < HotLevels)
+    {
+      best = std::min(best, _base + static_cast<int64_t>(i));
+    }
+    return best;
+  }
+
+  [[nodiscard]] Quantity levelAt(const Hot& hot, const FarLevels& far, int64_t t) const noexcept
+  {
+    if (inWindow(t))
+    {
+      return hot.get(static_cast<size_t>(t - _base));
+    }
+    const auto it = std::lower_bound(far.begin(), far.end(), t, tickLess);
+    return it != far.end() && it->first == t ? it->second : Quantity{};
+  }
+
+  void setLevel(Hot& hot, FarLevels& far, int64_t t, Quantity q)
+  {
+    if (inWindow(t))
+    {
+      hot.set(static_cast<size_t>(t - _base), q);
+      return;
+    }
+
+    const auto it = std::lower_bound(far.begin(), far.end(), t, tickLess);
+    if (it != far.end() && it->first == t)
+    {
+      if (q.isZero())
+      {
+        far.erase(it);
+      }
+      else
+      {
+        it->second = q;
+      }
+    }
+    else if (!q.isZero())
+    {
+      far.insert(it, FarLevel{t, q});
+    }
+  }
+
+  // Recenter once the touch leaves the middle three quarters of the window
+  void followTouch()
+  {
+    const auto center = touchCenter(bestBidTick(), bestAskTick());
+    if (!center)
+    {
+      return;
+    }
+    constexpr int64_t Margin = static_cast<int64_t>(HotLevels / 8);
+    if (*center >= _base + Margin && *center < _base + static_cast<int64_t>(HotLevels) - Margin)
+    {
+      return;
+    }
+
+    const int64_t base = *center - static_cast<int64_t>(HotLevels / 2);
+    recenter(_hotBids, _farBids, base);
+    recenter(_hotAsks, _farAsks, base);
+    _base = base;
+  }
+
+  // Move one side to the window starting at tick `base`
+  void recenter(Hot& hot, FarLevels& far, int64_t base)
+  {
+    constexpr int64_t Levels = static_cast<int64_t>(HotLevels);
+    const int64_t shift = base - _base;
+
+    // Levels scrolling out form one contiguous tick range, so they go into the overflow
+    // tier with a single insert
+    const bool all = shift >= Levels || shift <= -Levels;
+    const size_t from = all || shift > 0 ? 0 : static_cast<size_t>(Levels + shift);
+    const size_t to = all || shift < 0 ? HotLevels : static_cast<size_t>(shift);
+    _moved.clear();
+    hot.take(from, to, [&](size_t i, Quantity q)
+             { _moved.emplace_back(_base + static_cast<int64_t>(i), q); });
+    if (!_moved.empty())
+    {
+      const auto at = std::lower_bound(far.begin(), far.end(), _moved.front().first, tickLess);
+      far.insert(at, _moved.begin(), _moved.end());
+    }
+    hot.rotate(shift);
+
+    // Overflow levels scrolling in
+    const auto lo = std::lower_bound(far.begin(), far.end(), base, tickLess);
+    const auto hi = std::lower_bound(lo, far.end(), base + Levels, tickLess);
+    for (auto it = lo; it != hi; ++it)
+    {
+      hot.set(static_cast<size_t>(it->first - base), it->second);
+    }
+    far.erase(lo, hi);
+  }
+
+  Price _tickSize;
+  math::FastDiv64 _tickSizeDiv;
+
+  int64_t _base{0};  // tick of hot index 0
+
+  Hot _hotBids{};
+  Hot _hotAsks{};
+
+  FarLevels _farBids;
+  FarLevels _farAsks;
+  FarLevels _moved;  // scratch for recentering
+};
+
+}  // namespace flox
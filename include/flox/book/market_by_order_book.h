@@ -0,0 +1,427 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/abstract_order_book.h"
+#include "flox/book/events/mbo_update_event.h"
+#include "flox/book/mbo_update.h"
+#include "flox/common.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace flox
+{
+
+/**
+ * Market-by-order (L3) book: every resting order, in time priority within its level.
+ *
+ * Orders live in a fixed pool of nodes sized at construction; each price level chains its
+ * orders into an intrusive FIFO through node indices. An open-addressing table maps order
+ * ids to nodes, so add, modify and delete never allocate and never walk a queue. Level
+ * quantities are kept up to date on every message, so the IOrderBook queries cost the
+ * same as on an aggregated book.
+ */
+class MarketByOrderBook : public IOrderBook
+{
+ public:
+  // `maxOrders` resting orders fit in the pool; `levelReserve` price levels per side are
+  // reserved up front
+  explicit MarketByOrderBook(size_t maxOrders = 1 << 20, size_t levelReserve = 4096)
+      : _nodes(maxOrders), _index(maxOrders)
+  {
+    _bids.reserve(levelReserve);
+    _asks.reserve(levelReserve);
+    resetPool();
+  }
+
+  // Returns false if the message does not fit the book: an ADD with a known id or an empty
+  // quantity, a MODIFY/DELETE of an unknown id, or an ADD while the pool is full
+  bool apply(const MboUpdate& up)
+  {
+    switch (up.type)
+    {
+      case MboUpdateType::ADD:
+        return addOrder(up.orderId, up.side, up.price, up.quantity);
+      case MboUpdateType::MODIFY:
+        return modifyOrder(up.orderId, up.price, up.quantity);
+      case MboUpdateType::DELETE:
+        return deleteOrder(up.orderId);
+      case MboUpdateType::CLEAR:
+        clear();
+        return true;
+    }
+    return false;
+  }
+
+  bool apply(const MboUpdateEvent& ev) { return apply(ev.update); }
+
+  bool addOrder(OrderId id, Side side, Price price, Quantity qty)
+  {
+    if (qty.raw() <= 0 || _free == NIL)
+    {
+      return false;
+    }
+    const uint32_t n = _free;
+    if (!_index.insert(id, n))
+    {
+      return false;
+    }
+    _free = _nodes[n].next;
+    ++_orders;
+
+    Node& node = _nodes[n];
+    node.id = id;
+    node.price = price.raw();
+    node.qty = qty;
+    node.side = side;
+    link(n);
+    return true;
+  }
+
+  // A smaller quantity at the same price keeps the order's place in the queue; a new price
+  // or a larger quantity sends it to the back. A zero quantity deletes it.
+  bool modifyOrder(OrderId id, Price price, Quantity qty)
+  {
+    if (qty.raw() <= 0)
+    {
+      return deleteOrder(id);
+    }
+    const uint32_t n = _index.find(id);
+    if (n == NIL)
+    {
+      return false;
+    }
+
+    Node& node = _nodes[n];
+    if (node.price == price.raw() && qty <= node.qty)
+    {
+      findLevel(node.side, node.price)->qty -= node.qty - qty;
+      node.qty = qty;
+      return true;
+    }
+
+    unlink(n);
+    node.price = price.raw();
+    node.qty = qty;
+    link(n);
+    return true;
+  }
+
+  bool deleteOrder(OrderId id)
+  {
+    const uint32_t n = _index.erase(id);
+    if (n == NIL)
+    {
+      return false;
+    }
+    unlink(n);
+    _nodes[n].next = _free;
+    _free = n;
+    --_orders;
+    return true;
+  }
+
+  void clear()
+  {
+    _bids.clear();
+    _asks.clear();
+    _index.clear();
+    resetPool();
+  }
+
+  // Aggregated updates carry no order ids; an L3 book is driven through apply() only
+  void applyBookUpdate(const BookUpdateEvent&) override {}
+
+  [[nodiscard]] std::optional<Price> bestBid() const override
+  {
+    return _bids.empty() ? std::nullopt : std::optional(Price::fromRaw(_bids.back().price));
+  }
+
+  [[nodiscard]] std::optional<Price> bestAsk() const override
+  {
+    return _asks.empty() ? std::nullopt : std::optional(Price::fromRaw(_asks.back().price));
+  }
+
+  [[nodiscard]] Quantity bidAtPrice(Price p) const override { return levelQty(Side::BUY, p.raw()); }
+  [[nodiscard]] Quantity askAtPrice(Price p) const override { return levelQty(Side::SELL, p.raw()); }
+
+  // Walks asks upward from the best one; returns {filled quantity, notional}
+  [[nodiscard]] std::pair<double, double> consumeAsks(double needQtyBase) const noexcept
+  {
+    return consume(_asks, needQtyBase);
+  }
+
+  // Walks bids downward from the best one; returns {filled quantity, notional}
+  [[nodiscard]] std::pair<double, double> consumeBids(double needQtyBase) const noexcept
+  {
+    return consume(_bids, needQtyBase);
+  }
+
+  // Remaining quantity of a resting order
+  [[nodiscard]] std::optional<Quantity> orderQuantity(OrderId id) const
+  {
+    const uint32_t n = _index.find(id);
+    return n == NIL ? std::nullopt : std::optional(_nodes[n].qty);
+  }
+
+  // Calls f(orderId, quantity) for every order at the level, in time priority
+  template <typename F>
+  void forEachOrder(Side side, Price price, F&& f) const
+  {
+    const Level* lvl = findLevel(side, price.raw());
+    for (uint32_t n = lvl ? lvl->head : NIL; n != NIL; n = _nodes[n].next)
+    {
+      f(_nodes[n].id, _nodes[n].qty);
+    }
+  }
+
+  [[nodiscard]] size_t orderCount() const noexcept { return _orders; }
+  [[nodiscard]] size_t capacity() const noexcept { return _nodes.size(); }
+  [[nodiscard]] size_t bidLevels() const noexcept { return _bids.size(); }
+  [[nodiscard]] size_t askLevels() const noexcept { return _asks.size(); }
+
+ private:
+  static constexpr uint32_t NIL = UINT32_MAX;
+
+  // Most messages land a few levels from the touch; those are scanned before bisecting
+  static constexpr size_t NearTouchLevels = 8;
+
+  struct Node
+  {
+    OrderId id{};
+    int64_t price{};
+    Quantity qty{};
+    uint32_t prev{NIL};
+    uint32_t next{NIL};  // also links the free list
+    Side side{};
+  };
+
+  struct Level
+  {
+    int64_t price{};
+    Quantity qty{};  // sum over the queue
+    uint32_t head{NIL};
+    uint32_t tail{NIL};
+    uint32_t count{0};
+  };
+
+  // Sorted so that the best level is at the back: bids ascending, asks descending
+  using Levels = std::vector<Level>;
+
+  // Linear-probing map from order id to node, with backward-shift deletion so no
+  // tombstones build up under constant add/cancel churn
+  class OrderIndex
+  {
+   public:
+    explicit OrderIndex(size_t maxOrders)
+        : _slots(std::bit_ceil(std::max<size_t>(maxOrders * 2, 16))),
+          _mask(_slots.size() - 1),
+          _shift(64 - std::countr_zero(_slots.size()))
+    {
+    }
+
+    uint32_t find(OrderId id) const noexcept
+    {
+      for (size_t i = home(id);; i = (i + 1) & _mask)
+      {
+        const Slot& s = _slots[i];
+        if (s.node == NIL || s.id == id)
+        {
+          return s.node;
+        }
+      }
+    }
+
+    // False if the id is already present
+    bool insert(OrderId id, uint32_t node) noexcept
+    {
+      for (size_t i = home(id);; i = (i + 1) & _mask)
+      {
+        Slot& s = _slots[i];
+        if (s.node == NIL)
+        {
+          s = {id, node};
+          return true;
+        }
+        if (s.id == id)
+        {
+          return false;
+        }
+      }
+    }
+
+    // Returns the removed node, or NIL
+    uint32_t erase(OrderId id) noexcept
+    {
+      size_t i = home(id);
+      for (; _slots[i].node != NIL && _slots[i].id != id; i = (i + 1) & _mask)
+      {
+      }
+      const uint32_t node = _slots[i].node;
+      if (node == NIL)
+      {
+        return NIL;
+      }
+
+      // Pull later entries of the probe run back into the hole when their home allows it
+      for (size_t j = (i + 1) & _mask; _slots[j].node != NIL; j = (j + 1) & _mask)
+      {
+        if (((j - home(_slots[j].id)) & _mask) >= ((j - i) & _mask))
+        {
+          _slots[i] = _slots[j];
+          i = j;
+        }
+      }
+      _slots[i].node = NIL;
+      return node;
+    }
+
+    void clear() noexcept { std::fill(_slots.begin(), _slots.end(), Slot{}); }
+
+   private:
+    struct Slot
+    {
+      OrderId id{};
+      uint32_t node{NIL};
+    };
+
+    size_t home(OrderId id) const noexcept
+    {
+      return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> _shift);
+    }
+
+    std::vector<Slot> _slots;
+    size_t _mask;
+    int _shift;
+  };
+
+  static bool before(Side side, int64_t a, int64_t b) noexcept
+  {
+    return side == Side::BUY ? a < b : a > b;
+  }
+
+  Levels& levels(Side side) noexcept { return side == Side::BUY ? _bids : _asks; }
+  const Levels& levels(Side side) const noexcept { return side == Side::BUY ? _bids : _asks; }
+
+  // First level that does not sort before `price`
+  static Levels::const_iterator lowerBound(const Levels& lv, Side side, int64_t price) noexcept
+  {
+    const size_t near = std::min(lv.size(), NearTouchLevels);
+    auto it = lv.end();
+    for (size_t k = 0; k < near; ++k, --it)
+    {
+      if (before(side, (it - 1)->price, price))
+      {
+        return it;
+      }
+    }
+    return std::lower_bound(lv.begin(), it, price, [side](const Level& l, int64_t p)
+                            { return before(side, l.price, p); });
+  }
+
+  const Level* findLevel(Side side, int64_t price) const noexcept
+  {
+    const Levels& lv = levels(side);
+    const auto it = lowerBound(lv, side, price);
+    return it != lv.end() && it->price == price ? &*it : nullptr;
+  }
+
+  Level* findLevel(Side side, int64_t price) noexcept
+  {
+    return const_cast<Level*>(std::as_const(*this).findLevel(side, price));
+  }
+
+  [[nodiscard]] Quantity levelQty(Side side, int64_t price) const noexcept
+  {
+    const Level* lvl = findLevel(side, price);
+    return lvl ? lvl->qty : Quantity{};
+  }
+
+  // Appends a node to the back of its level's queue, creating the level if needed
+  void link(uint32_t n)
+  {
+    Node& node = _nodes[n];
+    Levels& lv = levels(node.side);
+    auto it = lv.begin() + (lowerBound(lv, node.side, node.price) - lv.cbegin());
+    if (it == lv.end() || it->price != node.price)
+    {
+      it = lv.insert(it, Level{node.price});
+    }
+
+    node.prev = it->tail;
+    node.next = NIL;
+    if (it->tail == NIL)
+    {
+      it->head = n;
+    }
+    else
+    {
+      _nodes[it->tail].next = n;
+    }
+    it->tail = n;
+    it->qty += node.qty;
+    ++it->count;
+  }
+
+  // Removes a node from its level's queue, dropping the level once it empties
+  void unlink(uint32_t n)
+  {
+    const Node& node = _nodes[n];
+    Levels& lv = levels(node.side);
+    auto it = lv.begin() + (lowerBound(lv, node.side, node.price) - lv.cbegin());
+
+    if (--it->count == 0)
+    {
+      lv.erase(it);
+      return;
+    }
+    (node.prev == NIL ? it->head : _nodes[node.prev].next) = node.next;
+    (node.next == NIL ? it->tail : _nodes[node.next].prev) = node.prev;
+    it->qty -= node.qty;
+  }
+
+  std::pair<double, double> consume(const Levels& lv, double needQtyBase) const noexcept
+  {
+    double rem = needQtyBase;
+    double notional = 0.0;
+    for (auto it = lv.rbegin(); it != lv.rend() && rem > 0.0; ++it)
+    {
+      const double take = std::min(rem, it->qty.toDouble());
+      notional += take * Price::fromRaw(it->price).toDouble();
+      rem -= take;
+    }
+    return {needQtyBase - rem, notional};
+  }
+
+  void resetPool() noexcept
+  {
+    for (size_t i = 0; i < _nodes.size(); ++i)
+    {
+      _nodes[i].next = i + 1 < _nodes.size() ? static_cast<uint32_t>(i + 1) : NIL;
+    }
+    _free = _nodes.empty() ? NIL : 0;
+    _orders = 0;
+  }
+
+  std::vector<Node> _nodes;
+  uint32_t _free{NIL};  // head of the free-node list
+  size_t _orders{0};
+  OrderIndex _index;
+
+  Levels _bids;
+  Levels _asks;
+};
+
+}  // namespace flox
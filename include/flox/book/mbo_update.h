@@ -0,0 +1,39 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/common.h"
+#include "flox/util/base/time.h"
+
+namespace flox
+{
+
+enum class MboUpdateType : uint8_t
+{
+  ADD,     // new resting order
+  MODIFY,  // new price and/or remaining quantity of a resting order
+  DELETE,  // order cancelled or fully filled
+  CLEAR    // every order of the symbol removed, e.g. before a replayed snapshot
+};
+
+// One order-level (market-by-order, L3) book message
+struct MboUpdate
+{
+  SymbolId symbol{};
+  InstrumentType instrument = InstrumentType::Spot;
+  MboUpdateType type{};
+  Side side{};
+  OrderId orderId{};
+  Price price{};
+  Quantity quantity{};  // remaining quantity for ADD/MODIFY
+  UnixNanos exchangeTsNs{0};
+};
+
+}  // namespace flox
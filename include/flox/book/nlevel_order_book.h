@@ -10,9 +10,12 @@
 #pragma once
 
 #include "flox/book/abstract_order_book.h"
+#include "flox/book/dense_levels.h"
+#include "flox/book/depth_kernels.h"
 #include "flox/book/events/book_update_event.h"
 #include "flox/common.h"
 #include "flox/util/base/math.h"
+#include "flox/util/base/occupancy_bitmap.h"
 
 #include <array>
 #include <charconv>
@@ -21,16 +24,26 @@
 #include <iomanip>
 #include <limits>
 #include <optional>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 namespace flox
 {
 
-template <size_t MaxLevels = 8192>
+/**
+ * Dense price-window order book.
+ *
+ * With `TopLevels` > 0 the book also keeps running sums over the best `TopLevels`
+ * non-empty levels of each side, updated in applyBookUpdate() from the changed levels
+ * only, so topBidVolume(), topImbalance() and depthWeightedMid() are O(1) reads.
+ */
+template <size_t MaxLevels = 8192, size_t TopLevels = 0>
 class NLevelOrderBook : public IOrderBook
 {
  public:
   static constexpr size_t MAX_LEVELS = MaxLevels;
+  static constexpr size_t TOP_LEVELS = TopLevels;
 
   explicit NLevelOrderBook(Price tickSize) noexcept
       : _tickSize(tickSize)
@@ -46,19 +59,8 @@ class NLevelOrderBook : public IOrderBook
       return _bestAskIdx;
     }
 
-    if (_minAsk >= MAX_LEVELS)
-    {
-      return std::nullopt;
-    }
-
-    for (size_t i = _minAsk; i <= _maxAsk && i < MAX_LEVELS; ++i)
-    {
-      if (!_asks[i].isZero())
-      {
-        return i;
-      }
-    }
-    return std::nullopt;
+    const size_t i = _asks.next(0);
+    return i < MAX_LEVELS ? std::optional<size_t>{i} : std::nullopt;
   }
 
   [[nodiscard]] inline std::optional<size_t> bestBidIndex() const noexcept
@@ -68,24 +70,8 @@ class NLevelOrderBook : public IOrderBook
       return _bestBidIdx;
     }
 
-    if (_minBid >= MAX_LEVELS)
-    {
-      return std::nullopt;
-    }
-
-    for (size_t i = _maxBid + 1; i-- > _minBid;)
-    {
-      if (!_bids[i].isZero())
-      {
-        return i;
-      }
-
-      if (i == 0)
-      {
-        break;
-      }
-    }
-    return std::nullopt;
+    const size_t i = _bids.prev(MAX_LEVELS - 1);
+    return i < MAX_LEVELS ? std::optional<size_t>{i} : std::nullopt;
   }
 
   void dump(std::ostream& os, size_t levels,
@@ -128,42 +114,23 @@ class NLevelOrderBook : public IOrderBook
 
     if (auto aIdxOpt = bestAskIndex())
     {
-      for (size_t i = *aIdxOpt; i <= _maxAsk && i < MAX_LEVELS && na < levels; ++i)
+      for (size_t i = *aIdxOpt; i < MAX_LEVELS && na < levels; i = _asks.next(i + 1))
       {
-        if (_asks[i].isZero())
-        {
-          continue;
-        }
-
         asks[na].have = true;
         asks[na].px = indexToPrice(i).toDouble();
-        asks[na].qty = _asks[i].toDouble();
+        asks[na].qty = _asks.get(i).toDouble();
         ++na;
       }
     }
 
     if (auto bIdxOpt = bestBidIndex())
     {
-      for (size_t i = *bIdxOpt + 1; i-- > _minBid && nb < levels;)
+      for (size_t i = *bIdxOpt; i < MAX_LEVELS && nb < levels; i = prevBid(i))
       {
-        if (_bids[i].isZero())
-        {
-          if (i == 0)
-          {
-            break;
-          }
-          continue;
-        }
-
         bids[nb].have = true;
         bids[nb].px = indexToPrice(i).toDouble();
-        bids[nb].qty = _bids[i].toDouble();
+        bids[nb].qty = _bids.get(i).toDouble();
         ++nb;
-
-        if (i == 0)
-        {
-          break;
-        }
       }
     }
 
@@ -316,29 +283,37 @@ class NLevelOrderBook : public IOrderBook
         reanchor(minIdx, maxIdx);
       }
 
-      _bids.fill({});
-      _asks.fill({});
+      _bids.clear();
+      _asks.clear();
       _minBid = _minAsk = MAX_LEVELS;
       _maxBid = _maxAsk = 0;
       _bestBidIdx = _bestAskIdx = MAX_LEVELS;
       _bestBidTick = _bestAskTick = -1;
     }
 
+    // A snapshot has re-anchored the window around all its levels; deltas move it
+    const bool slides = up.type == BookUpdateType::DELTA;
+
     for (const auto& [p, q] : up.bids)
     {
-      const size_t i = localIndex(p);
+      size_t i = localIndex(p);
       if (i >= MAX_LEVELS)
       {
-        continue;
+        if (!slides || q.isZero() || !slideTo(ticks(p)))
+        {
+          continue;
+        }
+        i = localIndex(p);
+        rebuildTop();
       }
 
-      const bool had = !_bids[i].isZero();
-      if (_bids[i].raw() == q.raw())
+      if (_bids.get(i).raw() == q.raw())
       {
         continue;
       }
 
-      _bids[i] = q;
+      const Quantity old = _bids.set(i, q);
+      const bool had = !old.isZero();
 
       if (!q.isZero())
       {
@@ -374,23 +349,36 @@ class NLevelOrderBook : public IOrderBook
           _maxBid = prevNonZeroBid(_maxBid);
         }
       }
+
+      if constexpr (TopLevels > 0)
+      {
+        if (slides)
+        {
+          trackTop<true>(i, old.raw(), q.raw());
+        }
+      }
     }
 
     for (const auto& [p, q] : up.asks)
     {
-      const size_t i = localIndex(p);
+      size_t i = localIndex(p);
       if (i >= MAX_LEVELS)
       {
-        continue;
+        if (!slides || q.isZero() || !slideTo(ticks(p)))
+        {
+          continue;
+        }
+        i = localIndex(p);
+        rebuildTop();
       }
 
-      const bool had = !_asks[i].isZero();
-      if (_asks[i].raw() == q.raw())
+      if (_asks.get(i).raw() == q.raw())
       {
         continue;
       }
 
-      _asks[i] = q;
+      const Quantity old = _asks.set(i, q);
+      const bool had = !old.isZero();
 
       if (!q.isZero())
       {
@@ -426,7 +414,76 @@ class NLevelOrderBook : public IOrderBook
           _maxAsk = prevNonZeroAsk(_maxAsk);
         }
       }
+
+      if constexpr (TopLevels > 0)
+      {
+        if (slides)
+        {
+          trackTop<false>(i, old.raw(), q.raw());
+        }
+      }
+    }
+
+    // A snapshot replaced the whole book; deltas were tracked level by level
+    if (!slides)
+    {
+      rebuildTop();
+    }
+  }
+
+  /**
+   * Applies a full snapshot by writing only the levels that differ from the current book
+   * and emptying those it no longer lists, instead of rebuilding both sides. Each change is
+   * reported as changed(side, price, quantity), zero quantity for a removed level, so the
+   * calls form the delta from the previous book to the new one. The resulting book is the
+   * same as applyBookUpdate() would build from the snapshot.
+   *
+   * Returns false if the window had to be re-anchored. The changes are still complete, but
+   * a book replaying them as a delta may not be able to slide that far; forward the
+   * snapshot itself in that case.
+   */
+  template <typename OnChange>
+  bool applySnapshotDiff(const BookUpdate& snapshot, OnChange&& changed)
+  {
+    const auto dropBid = [&](size_t i, Quantity) { changed(Side::BUY, indexToPrice(i), Quantity{}); };
+    const auto dropAsk = [&](size_t i, Quantity) { changed(Side::SELL, indexToPrice(i), Quantity{}); };
+
+    // Ticks of every level, bids then asks, computed once
+    _snapshotTicks.clear();
+    int64_t minIdx = std::numeric_limits<int64_t>::max();
+    int64_t maxIdx = std::numeric_limits<int64_t>::min();
+    for (const auto* side : {&snapshot.bids, &snapshot.asks})
+    {
+      for (const auto& [p, _] : *side)
+      {
+        const int64_t t = ticks(p);
+        _snapshotTicks.push_back(t);
+        minIdx = std::min(minIdx, t);
+        maxIdx = std::max(maxIdx, t);
+      }
+    }
+
+    if (minIdx == std::numeric_limits<int64_t>::max())
+    {
+      _bids.take(0, MAX_LEVELS, dropBid);
+      _asks.take(0, MAX_LEVELS, dropAsk);
+      clear();
+      return true;
     }
+
+    const int64_t base = anchorFor(minIdx, maxIdx);
+    const bool stays = base == _baseIndex;
+    if (!stays)
+    {
+      shiftWindow(base, dropBid, dropAsk);
+    }
+
+    const int64_t* bidTicks = _snapshotTicks.data();
+    diffSide(_bids, snapshot.bids, bidTicks, Side::BUY, changed);
+    diffSide(_asks, snapshot.asks, bidTicks + snapshot.bids.size(), Side::SELL, changed);
+    refreshBounds();
+    rebuildTop();
+    return stays;
   }
 
   [[nodiscard]] inline std::optional<Price> bestBid() const override
@@ -452,13 +509,13 @@ class NLevelOrderBook : public IOrderBook
   [[nodiscard]] inline Quantity bidAtPrice(Price p) const override
   {
     const size_t i = localIndex(p);
-    return i < MAX_LEVELS ? _bids[i] : Quantity{};
+    return i < MAX_LEVELS ? _bids.get(i) : Quantity{};
   }
 
   [[nodiscard]] inline Quantity askAtPrice(Price p) const override
   {
     const size_t i = localIndex(p);
-    return i < MAX_LEVELS ? _asks[i] : Quantity{};
+    return i < MAX_LEVELS ? _asks.get(i) : Quantity{};
   }
 
   [[nodiscard]] inline std::pair<double, double> consumeAsks(double needQtyBase) const noexcept
@@ -472,19 +529,16 @@ class NLevelOrderBook : public IOrderBook
     double notional = 0.0;
 
     const double ts = _tickSize.toDouble();
-    size_t i = _bestAskIdx;
-    const size_t hi = _maxAsk;
 
-    double px = ts * static_cast<double>(_baseIndex + static_cast<int64_t>(i));
-
-    for (; i <= hi && rem > math::EPS_QTY; ++i, px += ts)
+    for (size_t i = _bestAskIdx; i < MAX_LEVELS && rem > math::EPS_QTY; i = _asks.next(i + 1))
     {
-      const double q = _asks[i].toDouble();
+      const double q = _asks.get(i).toDouble();
       if (q <= 0.0)
       {
         continue;
       }
 
+      const double px = ts * static_cast<double>(_baseIndex + static_cast<int64_t>(i));
       const double take = q < rem ? q : rem;
       notional += take * px;
       rem -= take;
@@ -504,48 +558,324 @@ class NLevelOrderBook : public IOrderBook
     double notional = 0.0;
 
     const double ts = _tickSize.toDouble();
-    size_t i = _bestBidIdx;
-    const size_t lo = _minBid;
 
-    double px = ts * static_cast<double>(_baseIndex + static_cast<int64_t>(i));
+    for (size_t i = _bestBidIdx; i < MAX_LEVELS && rem > math::EPS_QTY; i = prevBid(i))
+    {
+      const double q = _bids.get(i).toDouble();
+      if (q <= 0.0)
+      {
+        continue;
+      }
+
+      const double px = ts * static_cast<double>(_baseIndex + static_cast<int64_t>(i));
+      const double take = q < rem ? q : rem;
+      notional += take * px;
+      rem -= take;
+    }
+
+    return {needQtyBase - rem, notional};
+  }
 
-    for (;;)
+  // Exact version of consumeAsks(): fixed point with 128-bit accumulation. Blocks of up to
+  // 64 levels that the remaining quantity covers are taken whole with the SIMD kernels;
+  // the block that completes the fill, or one holding a level too large for the 64-bit
+  // lanes, is taken level by level.
+  [[nodiscard]] DepthFill fillAsks(Quantity need) const noexcept
+  {
+    depth::FillAccumulator acc{need.raw(), _tickSize};
+
+    for (size_t i = _bestAskIdx; i < MAX_LEVELS && acc.remaining() > 0; i = _asks.next(i))
     {
-      if (rem <= math::EPS_QTY)
+      const auto run = _asks.runFrom(i);
+      const size_t n = std::min(run.size(), depth::BLOCK_LEVELS);
+      const int64_t tick = _baseIndex + static_cast<int64_t>(i);
+
+      if (depth::fitsLanes(run.data(), n))
+      {
+        const int64_t total = depth::sum(run.data(), n);
+        if (total < acc.remaining())
+        {
+          const size_t last = _asks.prev(i + n - 1);
+          acc.takeBlock(run.data(), n, tick, total, _baseIndex + static_cast<int64_t>(last));
+          i += n;
+          continue;
+        }
+      }
+
+      for (size_t k = 0; k < n && acc.take(tick + static_cast<int64_t>(k), run[k].raw()); ++k)
       {
-        break;
       }
+      i += n;
+    }
+
+    return acc.result();
+  }
+
+  // Exact version of consumeBids(); see fillAsks()
+  [[nodiscard]] DepthFill fillBids(Quantity need) const noexcept
+  {
+    depth::FillAccumulator acc{need.raw(), _tickSize};
+
+    for (size_t i = _bestBidIdx; i < MAX_LEVELS && acc.remaining() > 0;)
+    {
+      const auto run = _bids.runTo(i);
+      const size_t n = std::min(run.size(), depth::BLOCK_LEVELS);
+      const Quantity* block = run.data() + run.size() - n;
+      const size_t first = i + 1 - n;
+      const int64_t tick = _baseIndex + static_cast<int64_t>(first);
 
-      const double q = _bids[i].toDouble();
-      if (q > 0.0)
+      if (depth::fitsLanes(block, n))
       {
-        const double take = q < rem ? q : rem;
-        notional += take * px;
-        rem -= take;
+        const int64_t total = depth::sum(block, n);
+        if (total < acc.remaining())
+        {
+          const size_t last = _bids.next(first);
+          acc.takeBlock(block, n, tick, total, _baseIndex + static_cast<int64_t>(last));
+          i = prevBid(first);
+          continue;
+        }
       }
 
-      if (i == lo)
+      for (size_t k = n; k-- > 0 && acc.take(tick + static_cast<int64_t>(k), block[k].raw());)
       {
-        break;
       }
-      --i;
-      px -= ts;
+      i = prevBid(first);
     }
 
-    return {needQtyBase - rem, notional};
+    return acc.result();
+  }
+
+  // Total ask quantity priced at most `bps` basis points above the best ask
+  [[nodiscard]] Quantity askDepthWithinBps(uint32_t bps) const noexcept
+  {
+    if (_bestAskIdx >= MAX_LEVELS)
+    {
+      return {};
+    }
+
+    const size_t end = _bestAskIdx + std::min(bpsTicks(_bestAskTick, bps), MAX_LEVELS - 1 - _bestAskIdx) + 1;
+    int64_t total = 0;
+    for (size_t i = _bestAskIdx; i < end;)
+    {
+      const auto run = _asks.runFrom(i);
+      const size_t n = std::min(run.size(), end - i);
+      total += depth::sum(run.data(), n);
+      i += n;
+    }
+    return Quantity::fromRaw(total);
+  }
+
+  // Total bid quantity priced at most `bps` basis points below the best bid
+  [[nodiscard]] Quantity bidDepthWithinBps(uint32_t bps) const noexcept
+  {
+    if (_bestBidIdx >= MAX_LEVELS)
+    {
+      return {};
+    }
+
+    const size_t lo = _bestBidIdx - std::min(bpsTicks(_bestBidTick, bps), _bestBidIdx);
+    int64_t total = 0;
+    for (size_t i = _bestBidIdx + 1; i > lo;)
+    {
+      const auto run = _bids.runTo(i - 1);
+      const size_t n = std::min(run.size(), i - lo);
+      total += depth::sum(run.data() + run.size() - n, n);
+      i -= n;
+    }
+    return Quantity::fromRaw(total);
+  }
+
+  // out[k] = total ask quantity from the best ask up to k ticks above it. Returns the number
+  // of entries written, fewer than out.size() if the window ends first.
+  size_t cumulativeAskDepth(std::span<Quantity> out) const noexcept
+  {
+    if (_bestAskIdx >= MAX_LEVELS)
+    {
+      return 0;
+    }
+
+    const size_t end = _bestAskIdx + std::min(out.size(), MAX_LEVELS - _bestAskIdx);
+    int64_t carry = 0;
+    for (size_t i = _bestAskIdx; i < end;)
+    {
+      const auto run = _asks.runFrom(i);
+      const size_t n = std::min(run.size(), end - i);
+      carry = depth::prefixSum(run.data(), n, carry, out.data() + (i - _bestAskIdx));
+      i += n;
+    }
+    return end - _bestAskIdx;
+  }
+
+  // out[k] = total bid quantity from the best bid down to k ticks below it; see
+  // cumulativeAskDepth()
+  size_t cumulativeBidDepth(std::span<Quantity> out) const noexcept
+  {
+    if (_bestBidIdx >= MAX_LEVELS)
+    {
+      return 0;
+    }
+
+    const size_t count = std::min(out.size(), _bestBidIdx + 1);
+    int64_t carry = 0;
+    for (size_t w = 0; w < count;)
+    {
+      const auto run = _bids.runTo(_bestBidIdx - w);
+      const size_t n = std::min(run.size(), count - w);
+      for (size_t k = run.size(); k-- > run.size() - n;)
+      {
+        carry += run[k].raw();
+        out[w++] = Quantity::fromRaw(carry);
+      }
+    }
+    return count;
+  }
+
+  // Exact totals and VWAP over the best `levels` non-empty ask levels. Blocks are no
+  // longer than the levels still wanted, so each holds no more of them than needed and is
+  // taken whole, with the SIMD kernels unless a level is too large for the 64-bit lanes;
+  // the occupied count says how many it used up.
+  [[nodiscard]] DepthFill topAsks(size_t levels) const noexcept
+  {
+    depth::FillAccumulator acc{std::numeric_limits<int64_t>::max(), _tickSize};
+
+    for (size_t i = _bestAskIdx; i < MAX_LEVELS && levels > 0; i = _asks.next(i))
+    {
+      const auto run = _asks.runFrom(i);
+      const size_t n = std::min({run.size(), depth::BLOCK_LEVELS, levels});
+      const size_t last = _asks.prev(i + n - 1);
+      takeWhole<false>(acc, run.data(), n, _baseIndex + static_cast<int64_t>(i),
+                       _baseIndex + static_cast<int64_t>(last));
+      levels -= depth::occupied(run.data(), n);
+      i += n;
+    }
+
+    return acc.result();
+  }
+
+  // Exact totals and VWAP over the best `levels` non-empty bid levels; see topAsks()
+  [[nodiscard]] DepthFill topBids(size_t levels) const noexcept
+  {
+    depth::FillAccumulator acc{std::numeric_limits<int64_t>::max(), _tickSize};
+
+    for (size_t i = _bestBidIdx; i < MAX_LEVELS && levels > 0;)
+    {
+      const auto run = _bids.runTo(i);
+      const size_t n = std::min({run.size(), depth::BLOCK_LEVELS, levels});
+      const Quantity* block = run.data() + run.size() - n;
+      const size_t first = i + 1 - n;
+      const size_t last = _bids.next(first);
+      takeWhole<true>(acc, block, n, _baseIndex + static_cast<int64_t>(first),
+                      _baseIndex + static_cast<int64_t>(last));
+      levels -= depth::occupied(block, n);
+      i = prevBid(first);
+    }
+
+    return acc.result();
+  }
+
+  // Copies the best out.size() non-empty ask levels into `out`, best first; returns the count
+  size_t askDepth(std::span<BookLevel> out) const noexcept
+  {
+    size_t n = 0;
+    for (size_t i = _bestAskIdx; i < MAX_LEVELS && n < out.size(); i = _asks.next(i + 1))
+    {
+      out[n++] = {indexToPrice(i), _asks.get(i)};
+    }
+    return n;
+  }
+
+  // Copies the best out.size() non-empty bid levels into `out`, best first; returns the count
+  size_t bidDepth(std::span<BookLevel> out) const noexcept
+  {
+    size_t n = 0;
+    for (size_t i = _bestBidIdx; i < MAX_LEVELS && n < out.size(); i = prevBid(i))
+    {
+      out[n++] = {indexToPrice(i), _bids.get(i)};
+    }
+    return n;
+  }
+
+  // Touch microprice: the best prices weighted by the opposite side's quantity
+  [[nodiscard]] std::optional<Price> microprice() const noexcept
+  {
+    if (_bestBidIdx >= MAX_LEVELS || _bestAskIdx >= MAX_LEVELS)
+    {
+      return std::nullopt;
+    }
+    const int64_t bidQty = _bids.get(_bestBidIdx).raw();
+    const int64_t askQty = _asks.get(_bestAskIdx).raw();
+    const depth::i128 num = static_cast<depth::i128>(_bestBidTick) * askQty +
+                            static_cast<depth::i128>(_bestAskTick) * bidQty;
+    return Price::fromRaw(static_cast<int64_t>(num * _tickSize.raw() / (bidQty + askQty)));
+  }
+
+  // (bid - ask) / (bid + ask) of the quantities at the touch, in [-1, 1]; 0 for an empty book
+  [[nodiscard]] double queueImbalance() const noexcept
+  {
+    const int64_t bidQty = _bestBidIdx < MAX_LEVELS ? _bids.get(_bestBidIdx).raw() : 0;
+    const int64_t askQty = _bestAskIdx < MAX_LEVELS ? _asks.get(_bestAskIdx).raw() : 0;
+    return imbalance(bidQty, askQty);
+  }
+
+  // Spread relative to the mid, in basis points
+  [[nodiscard]] std::optional<double> spreadBps() const noexcept
+  {
+    if (_bestBidTick < 0 || _bestAskTick < 0)
+    {
+      return std::nullopt;
+    }
+    return 2e4 * static_cast<double>(_bestAskTick - _bestBidTick) /
+           static_cast<double>(_bestAskTick + _bestBidTick);
+  }
+
+  // Total quantity of the best TopLevels non-empty levels
+  [[nodiscard]] Quantity topBidVolume() const noexcept
+    requires(TopLevels > 0)
+  {
+    return Quantity::fromRaw(_topBids.qty);
+  }
+
+  [[nodiscard]] Quantity topAskVolume() const noexcept
+    requires(TopLevels > 0)
+  {
+    return Quantity::fromRaw(_topAsks.qty);
+  }
+
+  // queueImbalance() over the best TopLevels levels of each side
+  [[nodiscard]] double topImbalance() const noexcept
+    requires(TopLevels > 0)
+  {
+    return imbalance(_topBids.qty, _topAsks.qty);
+  }
+
+  // microprice() over the best TopLevels levels: each side's VWAP weighted by the
+  // opposite side's volume
+  [[nodiscard]] std::optional<Price> depthWeightedMid() const noexcept
+    requires(TopLevels > 0)
+  {
+    if (_topBids.qty == 0 || _topAsks.qty == 0)
+    {
+      return std::nullopt;
+    }
+    const depth::i128 bidVwap = _topBids.tickQty * _tickSize.raw() / _topBids.qty;
+    const depth::i128 askVwap = _topAsks.tickQty * _tickSize.raw() / _topAsks.qty;
+    const depth::i128 num = bidVwap * _topAsks.qty + askVwap * _topBids.qty;
+    return Price::fromRaw(static_cast<int64_t>(num / (_topBids.qty + _topAsks.qty)));
   }
 
   [[nodiscard]] inline Price tickSize() const noexcept { return _tickSize; }
 
   void clear() noexcept
   {
-    _bids.fill({});
-    _asks.fill({});
+    _bids.reset();
+    _asks.reset();
     _minBid = _minAsk = MAX_LEVELS;
     _maxBid = _maxAsk = 0;
     _baseIndex = 0;
     _bestBidIdx = _bestAskIdx = MAX_LEVELS;
     _bestBidTick = _bestAskTick = -1;
+    _topBids = {};
+    _topAsks = {};
   }
 
  private:
@@ -562,6 +892,31 @@ class NLevelOrderBook : public IOrderBook
     return Price::fromRaw(ts * tick);
   }
 
+  // Ticks spanned by `bps` basis points of the price at `tick`, capped at the window size
+  [[nodiscard]] static size_t bpsTicks(int64_t tick, uint32_t bps) noexcept
+  {
+    const __int128_t t = static_cast<__int128_t>(tick) * bps / 10'000;
+    return t < static_cast<__int128_t>(MAX_LEVELS) ? static_cast<size_t>(t) : MAX_LEVELS;
+  }
+
+  // Takes every level of q[0, n) into `acc`; the kernels when the block fits the 64-bit
+  // lanes, otherwise one level at a time from the best price down
+  template <bool Bid>
+  static void takeWhole(depth::FillAccumulator& acc, const Quantity* q, size_t n, int64_t firstTick,
+                        int64_t lastTick) noexcept
+  {
+    if (depth::fitsLanes(q, n))
+    {
+      acc.takeBlock(q, n, firstTick, depth::sum(q, n), lastTick);
+      return;
+    }
+    for (size_t j = 0; j < n; ++j)
+    {
+      const size_t k = Bid ? n - 1 - j : j;
+      acc.take(firstTick + static_cast<int64_t>(k), q[k].raw());
+    }
+  }
+
   [[nodiscard]] inline size_t localIndex(Price p) const noexcept
   {
     const int64_t t = ticks(p) - _baseIndex;
@@ -570,7 +925,11 @@ class NLevelOrderBook : public IOrderBook
                : MAX_LEVELS;
   }
 
-  void reanchor(int64_t minIdx, int64_t maxIdx) noexcept
+  void reanchor(int64_t minIdx, int64_t maxIdx) noexcept { _baseIndex = anchorFor(minIdx, maxIdx); }
+
+  // Window base for a snapshot spanning ticks [minIdx, maxIdx]; the current one if it
+  // already holds them with some margin
+  [[nodiscard]] int64_t anchorFor(int64_t minIdx, int64_t maxIdx) const noexcept
   {
     constexpr int64_t HYST = 8;
     const int64_t span = maxIdx - minIdx + 1;
@@ -579,91 +938,288 @@ class NLevelOrderBook : public IOrderBook
 
     if (curLo + HYST <= minIdx && maxIdx <= curHi - HYST)
     {
-      return;
+      return _baseIndex;
     }
 
     if (span >= static_cast<int64_t>(MAX_LEVELS))
     {
-      _baseIndex = minIdx;
+      return minIdx;
+    }
+    const int64_t mid = (minIdx + maxIdx) / 2;
+    return mid - static_cast<int64_t>(MAX_LEVELS / 2);
+  }
+
+  /**
+   * Slide the window so that tick `t` falls inside it while the best bid and ask stay
+   * inside, leaving some headroom in the direction of the move. Levels that scroll out
+   * are cleared; everything else keeps its slot. Returns false if `t` is too far from
+   * the top of book to fit.
+   */
+  bool slideTo(int64_t t) noexcept
+  {
+    constexpr int64_t Levels = static_cast<int64_t>(MAX_LEVELS);
+
+    int64_t lo = t, hi = t;
+    for (const int64_t best : {_bestBidTick, _bestAskTick})
+    {
+      if (best >= 0)
+      {
+        lo = std::min(lo, best);
+        hi = std::max(hi, best);
+      }
+    }
+    if (hi - lo >= Levels)
+    {
+      return false;
+    }
+
+    const int64_t headroom = std::min(Levels / 16, Levels - 1 - (hi - lo));
+    const int64_t base = t >= _baseIndex ? hi - (Levels - 1) + headroom : lo - headroom;
+
+    const auto drop = [](size_t, Quantity) {};
+    shiftWindow(base, drop, drop);
+    return true;
+  }
+
+  // Moves the window to start at tick `base`. Levels that scroll out are emptied through
+  // dropBid/dropAsk(index, quantity), called while indices still refer to the old base.
+  template <typename DropBid, typename DropAsk>
+  void shiftWindow(int64_t base, DropBid&& dropBid, DropAsk&& dropAsk)
+  {
+    constexpr int64_t Levels = static_cast<int64_t>(MAX_LEVELS);
+    const int64_t shift = base - _baseIndex;
+
+    if (shift >= Levels || shift <= -Levels)
+    {
+      _bids.take(0, MAX_LEVELS, dropBid);
+      _asks.take(0, MAX_LEVELS, dropAsk);
     }
     else
     {
-      const int64_t mid = (minIdx + maxIdx) / 2;
-      _baseIndex = mid - static_cast<int64_t>(MAX_LEVELS / 2);
+      const size_t from = shift > 0 ? 0 : static_cast<size_t>(Levels + shift);
+      const size_t to = shift > 0 ? static_cast<size_t>(shift) : MAX_LEVELS;
+      _bids.take(from, to, dropBid);
+      _asks.take(from, to, dropAsk);
+      _bids.rotate(shift);
+      _asks.rotate(shift);
     }
+    _baseIndex = base;
+    refreshBounds();
   }
 
-  [[nodiscard]] inline size_t nextNonZeroAsk(size_t from) const noexcept
+  // Recomputes the level bounds and the top of book from the occupancy bitmaps
+  void refreshBounds() noexcept
   {
-    for (size_t i = from; i < MAX_LEVELS; ++i)
+    // Indices are relative to the base; the top of book keeps its ticks
+    _minBid = _bids.next(0);
+    _maxBid = _bids.prev(MAX_LEVELS - 1);
+    _minAsk = _asks.next(0);
+    _maxAsk = _asks.prev(MAX_LEVELS - 1);
+    _bestBidIdx = _maxBid;
+    _bestAskIdx = _minAsk;
+    _bestBidTick = _bestBidIdx < MAX_LEVELS ? _baseIndex + static_cast<int64_t>(_bestBidIdx) : -1;
+    _bestAskTick = _bestAskIdx < MAX_LEVELS ? _baseIndex + static_cast<int64_t>(_bestAskIdx) : -1;
+    if (_minBid >= MAX_LEVELS)
     {
-      if (!_asks[i].isZero())
-      {
-        return i;
-      }
+      _maxBid = 0;
+    }
+    if (_minAsk >= MAX_LEVELS)
+    {
+      _maxAsk = 0;
     }
-    return MAX_LEVELS;
   }
 
-  [[nodiscard]] inline size_t prevNonZeroAsk(size_t from) const noexcept
+  // Writes the non-empty levels of `incoming` (at ticks `t`) that differ from `levels` and
+  // empties the levels missing from it, reporting each change. The walk for missing levels
+  // is skipped when every occupied level was matched.
+  template <typename OnChange>
+  void diffSide(DenseLevels<MAX_LEVELS>& levels, const std::pmr::vector<BookLevel>& incoming, const int64_t* t,
+                Side side, OnChange& changed)
   {
-    for (size_t i = from + 1; i-- > 0;)
+    const size_t occupied = levels.count();
+    size_t matched = 0;
+
+    for (size_t k = 0; k < incoming.size(); ++k)
+    {
+      const uint64_t i = static_cast<uint64_t>(t[k] - _baseIndex);
+      const Quantity q = incoming[k].quantity;
+      if (i >= MAX_LEVELS || q.isZero())
+      {
+        continue;
+      }
+      const bool repeated = _seen.test(i);
+      _seen.set(i);
+
+      const Quantity old = levels.get(i);
+      matched += !repeated && !old.isZero();
+      if (old.raw() != q.raw())
+      {
+        levels.set(i, q);
+        changed(side, indexToPrice(i), q);
+      }
+    }
+
+    if (matched < occupied)
     {
-      if (!_asks[i].isZero())
+      for (size_t i = levels.next(0); i < MAX_LEVELS; i = levels.next(i + 1))
       {
-        return i;
+        if (!_seen.test(i))
+        {
+          levels.set(i, Quantity{});
+          changed(side, indexToPrice(i), Quantity{});
+        }
       }
+    }
 
-      if (i == 0)
+    for (size_t k = 0; k < incoming.size(); ++k)
+    {
+      const uint64_t i = static_cast<uint64_t>(t[k] - _baseIndex);
+      if (i < MAX_LEVELS)
       {
-        break;
+        _seen.reset(i);
       }
     }
-    return MAX_LEVELS;
   }
 
-  [[nodiscard]] inline size_t nextNonZeroBid(size_t from) const noexcept
+  // Running sums over the best TopLevels non-empty levels of one side. `edge` is the worst
+  // level included; every non-empty level better than it is included as well.
+  struct TopSums
   {
-    for (size_t i = from; i < MAX_LEVELS; ++i)
+    int64_t qty{0};
+    depth::i128 tickQty{0};  // sum of tick * raw quantity
+    size_t count{0};
+    size_t edge{MAX_LEVELS};
+
+    void add(int64_t tick, int64_t q) noexcept
     {
-      if (!_bids[i].isZero())
+      qty += q;
+      tickQty += static_cast<depth::i128>(tick) * q;
+    }
+  };
+
+  [[nodiscard]] static double imbalance(int64_t bid, int64_t ask) noexcept
+  {
+    return bid + ask == 0 ? 0.0 : static_cast<double>(bid - ask) / static_cast<double>(bid + ask);
+  }
+
+  // Folds the change of level `i` from `old` to `q` into the sums of its side. Costs
+  // O(1) unless a level leaves the top, in which case the next one is found through the
+  // occupancy bitmap.
+  template <bool Bid>
+  void trackTop(size_t i, int64_t old, int64_t q) noexcept
+  {
+    TopSums& top = Bid ? _topBids : _topAsks;
+    const auto& side = Bid ? _bids : _asks;
+    const auto tick = [this](size_t k) { return _baseIndex + static_cast<int64_t>(k); };
+    const auto better = [](size_t a, size_t b) { return Bid ? a > b : a < b; };
+    // Nearest non-empty level strictly worse than `k`
+    const auto worse = [&](size_t k) { return Bid ? prevBid(k) : side.next(k + 1); };
+
+    const bool inTop = top.count > 0 && !better(top.edge, i);
+
+    if (old != 0 && q != 0)
+    {
+      if (inTop)
       {
-        return i;
+        top.add(tick(i), q - old);
       }
+      return;
+    }
+
+    if (q != 0)
+    {
+      if (top.count < TopLevels)
+      {
+        top.add(tick(i), q);
+        if (top.count++ == 0 || better(top.edge, i))
+        {
+          top.edge = i;
+        }
+      }
+      else if (better(i, top.edge))
+      {
+        // The new level pushes the worst one out
+        top.add(tick(i), q);
+        top.add(tick(top.edge), -side.get(top.edge).raw());
+        top.edge = Bid ? side.next(top.edge + 1) : side.prev(top.edge - 1);
+      }
+      return;
+    }
+
+    if (!inTop)
+    {
+      return;
+    }
+
+    top.add(tick(i), -old);
+    const bool wasFull = top.count-- == TopLevels;
+    const size_t next = wasFull ? worse(top.edge) : MAX_LEVELS;
+    if (next < MAX_LEVELS)
+    {
+      // The best level outside the top moves in
+      top.add(tick(next), side.get(next).raw());
+      ++top.count;
+      top.edge = next;
+    }
+    else if (i == top.edge)
+    {
+      top.edge = top.count == 0 ? MAX_LEVELS : (Bid ? side.next(i) : side.prev(i));
     }
-    return MAX_LEVELS;
   }
 
-  [[nodiscard]] inline size_t prevNonZeroBid(size_t from) const noexcept
+  // Recomputes the sums by walking the best TopLevels levels of each side
+  void rebuildTop() noexcept
   {
-    for (size_t i = from + 1; i-- > 0;)
+    if constexpr (TopLevels > 0)
     {
-      if (!_bids[i].isZero())
+      _topBids = {};
+      for (size_t i = _bestBidIdx; i < MAX_LEVELS && _topBids.count < TopLevels; i = prevBid(i))
       {
-        return i;
+        _topBids.add(_baseIndex + static_cast<int64_t>(i), _bids.get(i).raw());
+        _topBids.edge = i;
+        ++_topBids.count;
       }
 
-      if (i == 0)
+      _topAsks = {};
+      for (size_t i = _bestAskIdx; i < MAX_LEVELS && _topAsks.count < TopLevels; i = _asks.next(i + 1))
       {
-        break;
+        _topAsks.add(_baseIndex + static_cast<int64_t>(i), _asks.get(i).raw());
+        _topAsks.edge = i;
+        ++_topAsks.count;
       }
     }
-    return MAX_LEVELS;
+  }
+
+  [[nodiscard]] inline size_t nextNonZeroAsk(size_t from) const noexcept { return _asks.next(from); }
+  [[nodiscard]] inline size_t prevNonZeroAsk(size_t from) const noexcept { return _asks.prev(from); }
+  [[nodiscard]] inline size_t nextNonZeroBid(size_t from) const noexcept { return _bids.next(from); }
+  [[nodiscard]] inline size_t prevNonZeroBid(size_t from) const noexcept { return _bids.prev(from); }
+
+  // Next bid level below `i`, or MAX_LEVELS
+  [[nodiscard]] inline size_t prevBid(size_t i) const noexcept
+  {
+    return i == 0 ? MAX_LEVELS : _bids.prev(i - 1);
   }
 
  private:
   Price _tickSize;
   math::FastDiv64 _tickSizeDiv;
 
-  int64_t _baseIndex{0};
+  int64_t _baseIndex{0};  // tick of index 0
 
-  alignas(64) std::array<Quantity, MAX_LEVELS> _bids{};
-  alignas(64) std::array<Quantity, MAX_LEVELS> _asks{};
+  DenseLevels<MAX_LEVELS> _bids{};
+  DenseLevels<MAX_LEVELS> _asks{};
 
   size_t _minBid{MAX_LEVELS}, _maxBid{0}, _minAsk{MAX_LEVELS}, _maxAsk{0};
 
   size_t _bestBidIdx{MAX_LEVELS}, _bestAskIdx{MAX_LEVELS};
   int64_t _bestBidTick{-1}, _bestAskTick{-1};
+
+  TopSums _topBids{}, _topAsks{};
+
+  // Scratch for applySnapshotDiff(); `_seen` is empty between calls
+  OccupancyBitmap<MAX_LEVELS> _seen{};
+  std::vector<int64_t> _snapshotTicks;
 };
 
 }  // namespace flox
@@ -0,0 +1,186 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/book_sequencer.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/nlevel_order_book.h"
+#include "flox/common.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+#include "flox/engine/abstract_subsystem.h"
+#include "flox/engine/engine_config.h"
+#include "flox/engine/symbol_registry.h"
+#include "flox/util/memory/mapped_region.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace flox
+{
+
+/**
+ * One order book per symbol for a whole universe, in a single memory arena.
+ *
+ * Books live at fixed strides in one MappedRegion (huge pages by default), indexed
+ * directly by SymbolId, so a lookup is one multiply and book memory is reserved once up
+ * front instead of per strategy. Books are constructed when their symbol is added, with
+ * that symbol's tick size; pages of symbols never added are never touched.
+ *
+ * Subscribe the set once to the BookUpdateBus; it routes each update to its symbol's
+ * book. Books are written on that consumer's thread, so readers either share that
+ * thread (join its group) or go through a BookPublisher.
+ *
+ * With enableGapRecovery(), updates pass through a BookSequencer first: a symbol whose
+ * sequence breaks stops being updated until a snapshot arrives, while the others carry on.
+ */
+template <typename Book = NLevelOrderBook<>>
+class OrderBookSet : public ISubsystem, public IMarketDataSubscriber
+{
+ public:
+  static constexpr MemoryPlacement DefaultPlacement{.hugePages = true, .prefault = false};
+
+  // Symbols must be below `maxSymbols`
+  OrderBookSet(SubscriberId id, size_t maxSymbols, const MemoryPlacement& placement = DefaultPlacement)
+      : _id(id),
+        _maxSymbols(maxSymbols),
+        _arena(std::max<size_t>(maxSymbols, 1) * Stride, placement),
+        _live(maxSymbols, 0)
+  {
+  }
+
+  ~OrderBookSet() override
+  {
+    for (SymbolId s = 0; s < _maxSymbols; ++s)
+    {
+      if (_live[s])
+      {
+        slot(s)->~Book();
+      }
+    }
+  }
+
+  OrderBookSet(const OrderBookSet&) = delete;
+  OrderBookSet& operator=(const OrderBookSet&) = delete;
+
+  SubscriberId id() const override { return _id; }
+
+  // Creates the book of `symbol`, replacing an existing one; nullptr if `symbol` is out of range
+  Book* addSymbol(SymbolId symbol, Price tickSize)
+  {
+    if (symbol >= _maxSymbols)
+    {
+      return nullptr;
+    }
+    if (_live[symbol])
+    {
+      slot(symbol)->~Book();
+    }
+    else
+    {
+      _live[symbol] = 1;
+      ++_size;
+    }
+    if (_sequencer)
+    {
+      _sequencer->reset(symbol);
+    }
+    return new (slot(symbol)) Book(tickSize);
+  }
+
+  // Checks the sequence of every symbol's updates and resyncs a symbol from a snapshot
+  // after a gap; `request` is typically bound to IExchangeConnector::requestSnapshot().
+  // Call before the set is subscribed.
+  BookSequencer& enableGapRecovery(BookSequencer::SnapshotRequest request, BookSequencer::Options options = {})
+  {
+    _sequencer = std::make_unique<BookSequencer>(_maxSymbols, std::move(request), options);
+    return *_sequencer;
+  }
+
+  // Null unless gap recovery is enabled
+  [[nodiscard]] const BookSequencer* sequencer() const noexcept { return _sequencer.get(); }
+
+  // Whether the book of `symbol` is waiting for a snapshot after a gap; any thread
+  [[nodiscard]] bool isStale(SymbolId symbol) const noexcept
+  {
+    return _sequencer && _sequencer->isStale(symbol);
+  }
+
+  // Adds a book for every configured symbol with its SymbolConfig::tickSize, registering
+  // the symbols under their exchange name. Returns the number of books added; symbols whose
+  // id is out of range are skipped.
+  size_t addSymbols(const EngineConfig& config, SymbolRegistry& registry)
+  {
+    size_t added = 0;
+    for (const auto& exchange : config.exchanges)
+    {
+      for (const auto& sym : exchange.symbols)
+      {
+        const SymbolId id = registry.registerSymbol(exchange.name, sym.symbol);
+        added += addSymbol(id, Price::fromDouble(sym.tickSize)) != nullptr;
+      }
+    }
+    return added;
+  }
+
+  [[nodiscard]] Book* find(SymbolId symbol) noexcept
+  {
+    return symbol < _maxSymbols && _live[symbol] ? slot(symbol) : nullptr;
+  }
+
+  [[nodiscard]] const Book* find(SymbolId symbol) const noexcept
+  {
+    return symbol < _maxSymbols && _live[symbol] ? slot(symbol) : nullptr;
+  }
+
+  void onBookUpdate(const BookUpdateEvent& ev) override
+  {
+    Book* book = find(ev.update.symbol);
+    if (!book)
+    {
+      return;
+    }
+    if (_sequencer)
+    {
+      _sequencer->process(ev, [book](const BookUpdateEvent& e) { book->applyBookUpdate(e); });
+      return;
+    }
+    book->applyBookUpdate(ev);
+  }
+
+  [[nodiscard]] size_t size() const noexcept { return _size; }
+  [[nodiscard]] size_t maxSymbols() const noexcept { return _maxSymbols; }
+
+  // Bytes reserved for the arena and whether it got explicitly reserved huge pages
+  [[nodiscard]] size_t arenaBytes() const noexcept { return _arena.size(); }
+  [[nodiscard]] bool hugePages() const noexcept { return _arena.hugePages(); }
+
+ private:
+  // Whole cache lines per book, so neighbouring books never share a line
+  static constexpr size_t Stride = (sizeof(Book) + 63) / 64 * 64;
+  static_assert(alignof(Book) <= 64, "books are placed at cache-line strides");
+
+  Book* slot(SymbolId symbol) const noexcept
+  {
+    return std::launder(reinterpret_cast<Book*>(static_cast<std::byte*>(_arena.data()) + symbol * Stride));
+  }
+
+  SubscriberId _id;
+  size_t _maxSymbols;
+  size_t _size{0};
+  MappedRegion _arena;
+  std::vector<uint8_t> _live;  // per symbol: a book is constructed in its slot
+  std::unique_ptr<BookSequencer> _sequencer;
+};
+
+}  // namespace flox
@@ -0,0 +1,166 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/bus/book_update_bus.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/nlevel_order_book.h"
+#include "flox/common.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+#include "flox/util/base/time.h"
+#include "flox/util/memory/pool.h"
+#include "flox/util/performance/busy_backoff.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace flox
+{
+
+/**
+ * Turns a feed of full snapshots for one symbol into compact deltas.
+ *
+ * Each snapshot is diffed against the book with NLevelOrderBook::applySnapshotDiff(), so
+ * only levels that changed are written. When an output bus is given, the changed levels
+ * are republished on it as a DELTA event; snapshots that change nothing publish nothing.
+ * Incoming deltas are applied as usual and forwarded without their no-op levels.
+ *
+ * The first update is forwarded unchanged, so consumers of the output bus start from a
+ * full book. So is a snapshot that moves the book's price window, which a consumer could
+ * not follow through a delta. Forwarded events keep the incoming `seq`; `prevSeq` is the
+ * `seq` of the previous forwarded event, so skipped snapshots do not look like gaps
+ * downstream.
+ */
+template <typename Book = NLevelOrderBook<>, size_t PoolSize = 63>
+class SnapshotDiffer : public IMarketDataSubscriber
+{
+ public:
+  // `out` may be null to only maintain the book; `bookArgs` construct it, e.g. its tick size
+  template <typename... BookArgs>
+  SnapshotDiffer(SubscriberId id, SymbolId symbol, BookUpdateBus* out, BookArgs&&... bookArgs)
+      : _id(id), _symbol(symbol), _out(out), _book(std::forward<BookArgs>(bookArgs)...)
+  {
+  }
+
+  SubscriberId id() const override { return _id; }
+
+  void onBookUpdate(const BookUpdateEvent& ev) override
+  {
+    if (ev.update.symbol != _symbol)
+    {
+      return;
+    }
+
+    if (!_out)
+    {
+      apply(ev, [](Side, Price, Quantity) {});
+      return;
+    }
+
+    auto h = acquire();
+    BookUpdate& delta = h->update;
+    const bool forwardAsIs = !apply(ev, [&delta](Side side, Price p, Quantity q)
+                                    { (side == Side::BUY ? delta.bids : delta.asks).emplace_back(p, q); });
+
+    if (forwardAsIs)
+    {
+      delta.type = ev.update.type;
+      delta.bids.assign(ev.update.bids.begin(), ev.update.bids.end());
+      delta.asks.assign(ev.update.asks.begin(), ev.update.asks.end());
+    }
+    else if (delta.bids.empty() && delta.asks.empty())
+    {
+      ++_suppressed;
+      return;
+    }
+    else
+    {
+      delta.type = BookUpdateType::DELTA;
+    }
+
+    delta.symbol = ev.update.symbol;
+    delta.instrument = ev.update.instrument;
+    delta.exchangeTsNs = ev.update.exchangeTsNs;
+    delta.systemTsNs = ev.update.systemTsNs;
+    h->seq = ev.seq;
+    h->prevSeq = _lastSeq;
+    h->recvNs = ev.recvNs;
+    h->publishTsNs = nowNsMonotonic();
+    _lastSeq = ev.seq;
+
+    _out->publish(std::move(h));
+    ++_published;
+  }
+
+  [[nodiscard]] const Book& book() const noexcept { return _book; }
+  [[nodiscard]] SymbolId symbol() const noexcept { return _symbol; }
+
+  // Events published on the output bus, and updates dropped because they changed nothing
+  [[nodiscard]] uint64_t published() const noexcept { return _published; }
+  [[nodiscard]] uint64_t suppressed() const noexcept { return _suppressed; }
+
+ private:
+  // Applies `ev`, reporting the levels it changes; false if it must be forwarded as is
+  template <typename OnChange>
+  bool apply(const BookUpdateEvent& ev, OnChange&& changed)
+  {
+    const bool first = !_primed;
+    if (first || ev.update.type != BookUpdateType::SNAPSHOT)
+    {
+      // Levels whose quantity does not change are no-ops for the book and are not reported
+      for (const auto& [p, q] : ev.update.bids)
+      {
+        if (_book.bidAtPrice(p) != q)
+        {
+          changed(Side::BUY, p, q);
+        }
+      }
+      for (const auto& [p, q] : ev.update.asks)
+      {
+        if (_book.askAtPrice(p) != q)
+        {
+          changed(Side::SELL, p, q);
+        }
+      }
+      _book.applyBookUpdate(ev);
+      _primed = true;
+      return !first;
+    }
+    return _book.applySnapshotDiff(ev.update, changed);
+  }
+
+  // Output events go back to the pool once every consumer of the output bus is done with
+  // them; wait for one rather than lose changes
+  pool::Handle<BookUpdateEvent> acquire()
+  {
+    auto h = _pool.acquire();
+    BusyBackoff backoff;
+    while (!h)
+    {
+      backoff.pause();
+      h = _pool.acquire();
+    }
+    return std::move(*h);
+  }
+
+  SubscriberId _id;
+  SymbolId _symbol;
+  BookUpdateBus* _out;
+  Book _book;
+
+  bool _primed{false};
+  int64_t _lastSeq{0};
+  uint64_t _published{0};
+  uint64_t _suppressed{0};
+
+  pool::Pool<BookUpdateEvent, PoolSize> _pool;
+};
+
+}  // namespace flox
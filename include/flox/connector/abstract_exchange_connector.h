@@ -35,6 +35,11 @@ class IExchangeConnector : public ISubsystem
     _onTrade = std::move(onTrade);
   }
 
+  // Asks the venue for a fresh book snapshot of `symbol`, e.g. after a sequence gap. The
+  // snapshot arrives later through the book update callback. Returns false if the
+  // connector cannot request one; must not block.
+  virtual bool requestSnapshot(SymbolId /*symbol*/) { return false; }
+
  protected:
   void emitBookUpdate(const BookUpdateEvent& bu)
   {
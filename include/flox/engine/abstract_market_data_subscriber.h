@@ -11,12 +11,22 @@
 
 #include "flox/engine/abstract_subscriber.h"
 
+#include <cstdint>
+#include <span>
+
 namespace flox
 {
 
 class BookUpdateEvent;
 class TradeEvent;
 class CandleEvent;
+class MboUpdateEvent;
+
+namespace pool
+{
+template <typename T>
+class Handle;
+}
 
 class IMarketDataSubscriber : public ISubscriber
 {
@@ -26,6 +36,18 @@ class IMarketDataSubscriber : public ISubscriber
   virtual void onBookUpdate(const BookUpdateEvent& ev) {}
   virtual void onTrade(const TradeEvent& ev) {}
   virtual void onCandle(const CandleEvent& ev) {}
+  virtual void onMboUpdate(const MboUpdateEvent& ev) {}
+
+  // Batch hooks, called when a bus has several events ready for this subscriber.
+  // Return true if the batch was handled; false delivers it event by event instead.
+  virtual bool onBookUpdateBatch(std::span<const pool::Handle<BookUpdateEvent>> batch) { return false; }
+  virtual bool onTradeBatch(std::span<const TradeEvent> batch) { return false; }
+  virtual bool onCandleBatch(std::span<const CandleEvent> batch) { return false; }
+  virtual bool onMboUpdateBatch(std::span<const MboUpdateEvent> batch) { return false; }
+
+  // Latest update of a symbol from a conflating bus; `skipped` newer-than-seen versions
+  // were overwritten before this subscriber got to them
+  virtual void onConflatedBookUpdate(const BookUpdateEvent& ev, uint64_t skipped) { onBookUpdate(ev); }
 };
 
 }  // namespace flox
\ No newline at end of file
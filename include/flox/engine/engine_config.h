@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -36,10 +37,18 @@ struct KillSwitchConfig
   int maxOrdersPerSecond = -1;
 };
 
+struct EventBusConfig
+{
+  size_t capacity = 0;     // ring slots, a power of two; 0 keeps the bus type's default
+  bool hugePages = false;  // back the ring with huge pages
+  int numaNode = -1;       // NUMA node for the ring, -1 for the default policy
+};
+
 struct EngineConfig
 {
   std::vector<ExchangeConfig> exchanges;
   KillSwitchConfig killSwitchConfig;
+  EventBusConfig eventBus;
 
   std::string logLevel = "info";
   std::string logFile;
@@ -11,10 +11,13 @@
 
 #include "flox/aggregator/events/candle_event.h"
 #include "flox/book/events/book_update_event.h"
+#include "flox/book/events/mbo_update_event.h"
 #include "flox/book/events/trade_event.h"
 #include "flox/engine/abstract_market_data_subscriber.h"
 #include "flox/execution/events/order_event.h"
 
+#include <span>
+
 namespace flox
 {
 
@@ -28,6 +31,33 @@ struct EventDispatcher<pool::Handle<T>>
   {
     EventDispatcher<T>::dispatch(*ev, sub);
   }
+
+  static SymbolId symbolOf(const pool::Handle<T>& ev)
+    requires requires(const T& e) { EventDispatcher<T>::symbolOf(e); }
+  {
+    return EventDispatcher<T>::symbolOf(*ev);
+  }
+
+  static void dispatchConflated(const pool::Handle<T>& ev, uint64_t skipped, typename T::Listener& sub)
+    requires requires(const T& e) { EventDispatcher<T>::dispatchConflated(e, skipped, sub); }
+  {
+    EventDispatcher<T>::dispatchConflated(*ev, skipped, sub);
+  }
+
+  static void dispatchBatch(std::span<const pool::Handle<T>> evs, typename T::Listener& sub)
+  {
+    if constexpr (requires { EventDispatcher<T>::dispatchBatch(evs, sub); })
+    {
+      EventDispatcher<T>::dispatchBatch(evs, sub);
+    }
+    else
+    {
+      for (const auto& ev : evs)
+      {
+        dispatch(ev, sub);
+      }
+    }
+  }
 };
 
 template <>
@@ -37,6 +67,25 @@ struct EventDispatcher<BookUpdateEvent>
   {
     sub.onBookUpdate(ev);
   }
+
+  static SymbolId symbolOf(const BookUpdateEvent& ev) { return ev.update.symbol; }
+
+  static void dispatchConflated(const BookUpdateEvent& ev, uint64_t skipped, IMarketDataSubscriber& sub)
+  {
+    sub.onConflatedBookUpdate(ev, skipped);
+  }
+
+  static void dispatchBatch(std::span<const pool::Handle<BookUpdateEvent>> evs, IMarketDataSubscriber& sub)
+  {
+    if (sub.onBookUpdateBatch(evs))
+    {
+      return;
+    }
+    for (const auto& ev : evs)
+    {
+      sub.onBookUpdate(*ev);
+    }
+  }
 };
 
 template <>
@@ -46,6 +95,20 @@ struct EventDispatcher<TradeEvent>
   {
     sub.onTrade(ev);
   }
+
+  static SymbolId symbolOf(const TradeEvent& ev) { return ev.trade.symbol; }
+
+  static void dispatchBatch(std::span<const TradeEvent> evs, IMarketDataSubscriber& sub)
+  {
+    if (sub.onTradeBatch(evs))
+    {
+      return;
+    }
+    for (const auto& ev : evs)
+    {
+      sub.onTrade(ev);
+    }
+  }
 };
 
 template <>
@@ -55,6 +118,43 @@ struct EventDispatcher<CandleEvent>
   {
     sub.onCandle(ev);
   }
+
+  static SymbolId symbolOf(const CandleEvent& ev) { return ev.symbol; }
+
+  static void dispatchBatch(std::span<const CandleEvent> evs, IMarketDataSubscriber& sub)
+  {
+    if (sub.onCandleBatch(evs))
+    {
+      return;
+    }
+    for (const auto& ev : evs)
+    {
+      sub.onCandle(ev);
+    }
+  }
+};
+
+template <>
+struct EventDispatcher<MboUpdateEvent>
+{
+  static void dispatch(const MboUpdateEvent& ev, IMarketDataSubscriber& sub)
+  {
+    sub.onMboUpdate(ev);
+  }
+
+  static SymbolId symbolOf(const MboUpdateEvent& ev) { return ev.update.symbol; }
+
+  static void dispatchBatch(std::span<const MboUpdateEvent> evs, IMarketDataSubscriber& sub)
+  {
+    if (sub.onMboUpdateBatch(evs))
+    {
+      return;
+    }
+    for (const auto& ev : evs)
+    {
+      sub.onMboUpdate(ev);
+    }
+  }
 };
 
 template <>
@@ -62,8 +162,26 @@ struct EventDispatcher<OrderEvent>
 {
   static void dispatch(const OrderEvent& ev, IOrderExecutionListener& listener)
   {
+    if (listener.onOrderEvent(ev))
+    {
+      return;
+    }
     ev.dispatchTo(listener);
   }
+
+  static SymbolId symbolOf(const OrderEvent& ev) { return ev.order.symbol; }
+
+  static void dispatchBatch(std::span<const OrderEvent> evs, IOrderExecutionListener& listener)
+  {
+    if (listener.onOrderEventBatch(evs))
+    {
+      return;
+    }
+    for (const auto& ev : evs)
+    {
+      dispatch(ev, listener);
+    }
+  }
 };
 
 }  // namespace flox
\ No newline at end of file
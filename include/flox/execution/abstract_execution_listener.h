@@ -12,9 +12,13 @@
 #include "flox/engine/abstract_subscriber.h"
 #include "flox/execution/order.h"
 
+#include <span>
+
 namespace flox
 {
 
+struct OrderEvent;
+
 class IOrderExecutionListener : public ISubscriber
 {
   SubscriberId _id{};
@@ -34,6 +38,14 @@ class IOrderExecutionListener : public ISubscriber
   virtual void onOrderExpired(const Order& order) = 0;
   virtual void onOrderRejected(const Order& order, const std::string& reason) = 0;
   virtual void onOrderReplaced(const Order& oldOrder, const Order& newOrder) = 0;
+
+  // Called with the raw event before the per-status callbacks above.
+  // Return true if the event was handled; false dispatches it by status instead.
+  virtual bool onOrderEvent(const OrderEvent& ev) { return false; }
+
+  // Called when a bus has several order events ready for this listener.
+  // Return true if the batch was handled; false delivers it event by event instead.
+  virtual bool onOrderEventBatch(std::span<const OrderEvent> batch) { return false; }
 };
 
 }  // namespace flox
\ No newline at end of file
@@ -0,0 +1,193 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace flox
+{
+
+/**
+ * Two-level bitmap over N slots: one bit per slot plus a summary bit per non-empty
+ * 64-slot word.
+ *
+ * next()/prev() find the nearest set slot with one ctz/clz on the slot word and, when
+ * that word is empty, on the summary words, so a search over an empty stretch of S slots
+ * costs about S / 4096 loads instead of S.
+ */
+template <size_t N>
+class OccupancyBitmap
+{
+  static_assert(N > 0, "OccupancyBitmap needs at least one slot");
+
+ public:
+  static constexpr size_t SIZE = N;
+  static constexpr size_t NPOS = N;
+
+  void set(size_t i) noexcept
+  {
+    const size_t w = i >> 6;
+    _words[w] |= bit(i);
+    _summary[w >> 6] |= bit(w);
+  }
+
+  void reset(size_t i) noexcept
+  {
+    const size_t w = i >> 6;
+    _words[w] &= ~bit(i);
+    if (_words[w] == 0)
+    {
+      _summary[w >> 6] &= ~bit(w);
+    }
+  }
+
+  [[nodiscard]] bool test(size_t i) const noexcept { return (_words[i >> 6] & bit(i)) != 0; }
+
+  [[nodiscard]] bool any() const noexcept
+  {
+    for (const uint64_t s : _summary)
+    {
+      if (s)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Number of set slots; visits only the non-empty words
+  [[nodiscard]] size_t count() const noexcept
+  {
+    size_t n = 0;
+    for (size_t s = 0; s < SummaryWords; ++s)
+    {
+      for (uint64_t bits = _summary[s]; bits; bits &= bits - 1)
+      {
+        n += static_cast<size_t>(std::popcount(_words[(s << 6) + static_cast<size_t>(std::countr_zero(bits))]));
+      }
+    }
+    return n;
+  }
+
+  void clear() noexcept
+  {
+    _words.fill(0);
+    _summary.fill(0);
+  }
+
+  // First set slot at or after `from`, or NPOS
+  [[nodiscard]] size_t next(size_t from) const noexcept
+  {
+    if (from >= N)
+    {
+      return NPOS;
+    }
+    size_t w = from >> 6;
+    const uint64_t bits = _words[w] & (~uint64_t{0} << (from & 63));
+    if (bits)
+    {
+      return (w << 6) + static_cast<size_t>(std::countr_zero(bits));
+    }
+
+    w = nextWord(w + 1);
+    return w < Words ? (w << 6) + static_cast<size_t>(std::countr_zero(_words[w])) : NPOS;
+  }
+
+  // Last set slot at or before `from` (clamped to N - 1), or NPOS
+  [[nodiscard]] size_t prev(size_t from) const noexcept
+  {
+    if (from >= N)
+    {
+      from = N - 1;
+    }
+    size_t w = from >> 6;
+    const uint64_t bits = _words[w] & upTo(from);
+    if (bits)
+    {
+      return (w << 6) + 63 - static_cast<size_t>(std::countl_zero(bits));
+    }
+    if (w == 0)
+    {
+      return NPOS;
+    }
+
+    w = prevWord(w - 1);
+    return w < Words ? (w << 6) + 63 - static_cast<size_t>(std::countl_zero(_words[w])) : NPOS;
+  }
+
+  // Calls f(i) for every set slot in [from, to], ascending
+  template <typename F>
+  void forEach(size_t from, size_t to, F&& f) const
+  {
+    for (size_t i = next(from); i <= to && i < N; i = next(i + 1))
+    {
+      f(i);
+    }
+  }
+
+ private:
+  static constexpr size_t Words = (N + 63) / 64;
+  static constexpr size_t SummaryWords = (Words + 63) / 64;
+
+  static constexpr uint64_t bit(size_t i) noexcept { return uint64_t{1} << (i & 63); }
+
+  // Bits 0..(i & 63) inclusive
+  static constexpr uint64_t upTo(size_t i) noexcept { return ~uint64_t{0} >> (63 - (i & 63)); }
+
+  // First non-empty word at or after `w`, or Words
+  size_t nextWord(size_t w) const noexcept
+  {
+    if (w >= Words)
+    {
+      return Words;
+    }
+    size_t s = w >> 6;
+    uint64_t bits = _summary[s] & (~uint64_t{0} << (w & 63));
+    for (;;)
+    {
+      if (bits)
+      {
+        return (s << 6) + static_cast<size_t>(std::countr_zero(bits));
+      }
+      if (++s >= SummaryWords)
+      {
+        return Words;
+      }
+      bits = _summary[s];
+    }
+  }
+
+  // Last non-empty word at or before `w`, or Words
+  size_t prevWord(size_t w) const noexcept
+  {
+    size_t s = w >> 6;
+    uint64_t bits = _summary[s] & upTo(w);
+    for (;;)
+    {
+      if (bits)
+      {
+        return (s << 6) + 63 - static_cast<size_t>(std::countl_zero(bits));
+      }
+      if (s-- == 0)
+      {
+        return Words;
+      }
+      bits = _summary[s];
+    }
+  }
+
+  std::array<uint64_t, Words> _words{};
+  std::array<uint64_t, SummaryWords> _summary{};
+};
+
+}  // namespace flox
@@ -0,0 +1,107 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/util/performance/busy_backoff.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace flox
+{
+
+/**
+ * Single-writer, multi-reader sequence lock around a trivially copyable value.
+ *
+ * The writer never waits: it bumps the sequence to odd, stores the value and bumps it
+ * back to even. Readers copy the value and retry if the sequence was odd or changed
+ * while they copied, so they never block the writer and never see a torn value.
+ *
+ * The value is stored as 64-bit words accessed through relaxed atomics, so concurrent
+ * copies are race-free under the C++ memory model, not only on x86.
+ */
+template <typename T>
+class SeqLock
+{
+  static_assert(std::is_trivially_copyable_v<T>, "SeqLock needs a trivially copyable value");
+
+ public:
+  SeqLock() : SeqLock(T{}) {}
+  explicit SeqLock(const T& value) { std::memcpy(_words, &value, sizeof(T)); }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  // Writer thread only
+  void store(const T& value) noexcept
+  {
+    uint64_t words[Words]{};
+    std::memcpy(words, &value, sizeof(T));
+
+    const uint64_t seq = _seq.load(std::memory_order_relaxed);
+    _seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < Words; ++i)
+    {
+      std::atomic_ref<uint64_t>(_words[i]).store(words[i], std::memory_order_relaxed);
+    }
+    _seq.store(seq + 2, std::memory_order_release);
+  }
+
+  // One attempt; false if the writer was active during the copy
+  bool tryLoad(T& out) const noexcept
+  {
+    const uint64_t before = _seq.load(std::memory_order_acquire);
+    if (before & 1)
+    {
+      return false;
+    }
+
+    uint64_t words[Words];
+    for (size_t i = 0; i < Words; ++i)
+    {
+      words[i] = std::atomic_ref<uint64_t>(_words[i]).load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_seq.load(std::memory_order_relaxed) != before)
+    {
+      return false;
+    }
+
+    std::memcpy(&out, words, sizeof(T));
+    return true;
+  }
+
+  // Retries until a consistent copy is read
+  [[nodiscard]] T load() const noexcept
+  {
+    T out;
+    BusyBackoff backoff;
+    while (!tryLoad(out))
+    {
+      backoff.pause();
+    }
+    return out;
+  }
+
+  // Completed store() calls so far; readers can poll it to skip copies of an unchanged value
+  [[nodiscard]] uint64_t version() const noexcept { return _seq.load(std::memory_order_acquire) >> 1; }
+
+ private:
+  static constexpr size_t Words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  alignas(64) std::atomic<uint64_t> _seq{0};
+  mutable uint64_t _words[Words]{};
+};
+
+}  // namespace flox
@@ -0,0 +1,191 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/util/performance/busy_backoff.h"
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace flox
+{
+
+struct WaitStrategy
+{
+  enum class Kind
+  {
+    BusySpin,   // never leaves the core: lowest latency, burns it completely
+    SpinYield,  // spins, then yields the time slice on every further miss
+    Park,       // spins, then sleeps on a futex until the other side signals
+    TimedPark   // like Park, but also wakes up after parkTimeout without a signal
+  };
+
+  Kind kind{Kind::SpinYield};
+  uint32_t spinLimit{2048};
+  std::chrono::microseconds parkTimeout{1000};
+
+  static constexpr WaitStrategy busySpin() { return {Kind::BusySpin, 0, {}}; }
+  static constexpr WaitStrategy spinYield(uint32_t spins = 2048) { return {Kind::SpinYield, spins, {}}; }
+  static constexpr WaitStrategy park(uint32_t spins = 2048) { return {Kind::Park, spins, std::chrono::microseconds{1000}}; }
+  static constexpr WaitStrategy timedPark(std::chrono::microseconds timeout, uint32_t spins = 2048)
+  {
+    return {Kind::TimedPark, spins, timeout};
+  }
+
+  constexpr bool parks() const noexcept { return kind == Kind::Park || kind == Kind::TimedPark; }
+};
+
+/**
+ * Futex-backed wakeup channel between a signalling side and parked waiters.
+ *
+ * A waiter announces itself with prepareToPark(), re-checks its condition and only then
+ * calls park(). notifyAll() costs one fence and one load while nobody is parked.
+ */
+class ParkingSignal
+{
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+ public:
+  uint32_t prepareToPark() noexcept
+  {
+    _waiters.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return _epoch.load(std::memory_order_acquire);
+  }
+
+  void cancelPark() noexcept { _waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+  // Sleep until notified or, with a non-zero timeout, until it expires
+  void park(uint32_t epoch, std::chrono::nanoseconds timeout) noexcept
+  {
+#if defined(__linux__)
+    auto* addr = reinterpret_cast<uint32_t*>(&_epoch);
+    if (timeout.count() > 0)
+    {
+      timespec ts{};
+      ts.tv_sec = static_cast<time_t>(timeout.count() / 1'000'000'000);
+      ts.tv_nsec = static_cast<long>(timeout.count() % 1'000'000'000);
+      syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, epoch, &ts, nullptr, 0);
+    }
+    else
+    {
+      syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+    }
+#else
+    if (timeout.count() > 0)
+    {
+      std::this_thread::sleep_for(timeout);
+    }
+    else
+    {
+      _epoch.wait(epoch, std::memory_order_acquire);
+    }
+#endif
+    _waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void notifyAll() noexcept
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiters.load(std::memory_order_relaxed) == 0)
+    {
+      return;
+    }
+
+    _epoch.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    _epoch.notify_all();
+#endif
+  }
+
+ private:
+  alignas(64) std::atomic<uint32_t> _epoch{0};
+  std::atomic<uint32_t> _waiters{0};
+};
+
+// Idle-loop state of one waiting thread, driven by a WaitStrategy
+class Waiter
+{
+ public:
+  explicit Waiter(const WaitStrategy& strategy, ParkingSignal* signal = nullptr) noexcept
+      : _strategy(strategy), _signal(signal)
+  {
+  }
+
+  // One idle step. `ready` is re-checked right before parking, so a signal sent after
+  // the caller's last check is never lost.
+  template <typename Ready>
+  void pause(Ready&& ready)
+  {
+    if (_strategy.kind == WaitStrategy::Kind::BusySpin)
+    {
+      cpuRelax();
+      return;
+    }
+
+    if (_spins < _strategy.spinLimit)
+    {
+      cpuRelax();
+      ++_spins;
+      return;
+    }
+
+    if (!_strategy.parks())
+    {
+      std::this_thread::yield();
+      return;
+    }
+
+    if (_signal == nullptr)
+    {
+      // Nobody will signal this waiter: fall back to a plain timed sleep
+      std::this_thread::sleep_for(_strategy.parkTimeout);
+      return;
+    }
+
+    const uint32_t epoch = _signal->prepareToPark();
+    if (ready())
+    {
+      _signal->cancelPark();
+      return;
+    }
+
+    const std::chrono::nanoseconds timeout =
+        _strategy.kind == WaitStrategy::Kind::TimedPark ? _strategy.parkTimeout : std::chrono::nanoseconds{0};
+    _signal->park(epoch, timeout);
+  }
+
+  void pause()
+  {
+    pause([]
+          { return false; });
+  }
+
+  void reset() noexcept { _spins = 0; }
+
+ private:
+  WaitStrategy _strategy;
+  ParkingSignal* _signal;
+  uint32_t _spins{0};
+};
+
+}  // namespace flox
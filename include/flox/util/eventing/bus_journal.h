@@ -0,0 +1,442 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/aggregator/events/candle_event.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/events/trade_event.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+#include "flox/execution/abstract_execution_listener.h"
+#include "flox/execution/events/order_event.h"
+#include "flox/util/eventing/journal.h"
+#include "flox/util/memory/pool.h"
+#include "flox/util/performance/profile.h"
+
+#include <cstring>
+#include <span>
+
+namespace flox
+{
+
+namespace detail
+{
+
+struct JournalOut
+{
+  std::byte* p;
+
+  template <typename T>
+  void put(T v)
+  {
+    std::memcpy(p, &v, sizeof(v));
+    p += sizeof(v);
+  }
+};
+
+struct JournalIn
+{
+  const std::byte* p;
+
+  template <typename T>
+  T get()
+  {
+    T v;
+    std::memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return v;
+  }
+};
+
+inline int64_t timeNs(TimePoint t) { return t.time_since_epoch().count(); }
+inline TimePoint timeFromNs(int64_t ns) { return TimePoint(FloxClock::duration(ns)); }
+
+}  // namespace detail
+
+/**
+ * Binary layout of a journaled event: fixed-width fields in host byte order, no padding.
+ * encode() writes exactly size(ev) bytes; decode() reads them back into `ev`.
+ */
+template <typename Event>
+struct JournalCodec;
+
+template <>
+struct JournalCodec<TradeEvent>
+{
+  static constexpr JournalRecordType Type = JournalRecordType::Trade;
+
+  static uint32_t size(const TradeEvent&) { return 8 + 7 * 8; }
+  static int64_t publishNs(const TradeEvent& ev) { return static_cast<int64_t>(ev.publishTsNs); }
+
+  static void encode(const TradeEvent& ev, std::byte* p)
+  {
+    detail::JournalOut out{p};
+    out.put<uint32_t>(ev.trade.symbol);
+    out.put<uint8_t>(static_cast<uint8_t>(ev.trade.instrument));
+    out.put<uint8_t>(ev.trade.isBuy);
+    out.put<uint16_t>(0);
+    out.put<int64_t>(ev.trade.price.raw());
+    out.put<int64_t>(ev.trade.quantity.raw());
+    out.put<int64_t>(ev.trade.exchangeTsNs);
+    out.put<int64_t>(ev.seq);
+    out.put<uint64_t>(ev.trade_id);
+    out.put<uint64_t>(ev.recvNs);
+    out.put<int64_t>(ev.exchangeMsgTsNs);
+  }
+
+  static void decode(const JournalRecordHeader& rec, std::span<const std::byte> payload, TradeEvent& ev)
+  {
+    detail::JournalIn in{payload.data()};
+    ev.trade.symbol = in.get<uint32_t>();
+    ev.trade.instrument = static_cast<InstrumentType>(in.get<uint8_t>());
+    ev.trade.isBuy = in.get<uint8_t>() != 0;
+    in.get<uint16_t>();
+    ev.trade.price = Price::fromRaw(in.get<int64_t>());
+    ev.trade.quantity = Quantity::fromRaw(in.get<int64_t>());
+    ev.trade.exchangeTsNs = in.get<int64_t>();
+    ev.seq = in.get<int64_t>();
+    ev.trade_id = in.get<uint64_t>();
+    ev.recvNs = in.get<uint64_t>();
+    ev.exchangeMsgTsNs = in.get<int64_t>();
+    ev.tickSequence = rec.tickSequence;
+    ev.publishTsNs = static_cast<MonoNanos>(rec.publishNs);
+  }
+};
+
+// Header, then bids and asks as (price, quantity) raw pairs
+template <>
+struct JournalCodec<BookUpdateEvent>
+{
+  static constexpr JournalRecordType Type = JournalRecordType::BookUpdate;
+
+  static constexpr uint32_t FixedBytes = 8 + 7 * 8 + 8;
+  static constexpr uint32_t LevelBytes = 16;
+
+  enum : uint8_t
+  {
+    HasStrike = 1,
+    HasExpiry = 2,
+    HasOptionType = 4
+  };
+
+  static uint32_t size(const BookUpdateEvent& ev)
+  {
+    return FixedBytes + LevelBytes * static_cast<uint32_t>(ev.update.bids.size() + ev.update.asks.size());
+  }
+
+  static int64_t publishNs(const BookUpdateEvent& ev) { return static_cast<int64_t>(ev.publishTsNs); }
+
+  static void encode(const BookUpdateEvent& ev, std::byte* p)
+  {
+    const auto& u = ev.update;
+    detail::JournalOut out{p};
+    out.put<uint32_t>(u.symbol);
+    out.put<uint8_t>(static_cast<uint8_t>(u.instrument));
+    out.put<uint8_t>(static_cast<uint8_t>(u.type));
+    out.put<uint8_t>((u.strike ? HasStrike : 0) | (u.expiry ? HasExpiry : 0) |
+                     (u.optionType ? HasOptionType : 0));
+    out.put<uint8_t>(u.optionType ? static_cast<uint8_t>(*u.optionType) : 0);
+    out.put<int64_t>(ev.seq);
+    out.put<int64_t>(ev.prevSeq);
+    out.put<int64_t>(u.exchangeTsNs);
+    out.put<int64_t>(u.systemTsNs);
+    out.put<uint64_t>(ev.recvNs);
+    out.put<int64_t>(u.strike ? u.strike->raw() : 0);
+    out.put<int64_t>(u.expiry ? detail::timeNs(*u.expiry) : 0);
+    out.put<uint32_t>(static_cast<uint32_t>(u.bids.size()));
+    out.put<uint32_t>(static_cast<uint32_t>(u.asks.size()));
+    for (const auto* side : {&u.bids, &u.asks})
+    {
+      for (const auto& level : *side)
+      {
+        out.put<int64_t>(level.price.raw());
+        out.put<int64_t>(level.quantity.raw());
+      }
+    }
+  }
+
+  // `ev` keeps its memory resource; its levels are replaced
+  static void decode(const JournalRecordHeader& rec, std::span<const std::byte> payload, BookUpdateEvent& ev)
+  {
+    auto& u = ev.update;
+    detail::JournalIn in{payload.data()};
+    u.symbol = in.get<uint32_t>();
+    u.instrument = static_cast<InstrumentType>(in.get<uint8_t>());
+    u.type = static_cast<BookUpdateType>(in.get<uint8_t>());
+    const uint8_t flags = in.get<uint8_t>();
+    const auto optionType = static_cast<OptionType>(in.get<uint8_t>());
+    ev.seq = in.get<int64_t>();
+    ev.prevSeq = in.get<int64_t>();
+    u.exchangeTsNs = in.get<int64_t>();
+    u.systemTsNs = in.get<int64_t>();
+    ev.recvNs = in.get<uint64_t>();
+    const int64_t strike = in.get<int64_t>();
+    const int64_t expiry = in.get<int64_t>();
+    const uint32_t bids = in.get<uint32_t>();
+    const uint32_t asks = in.get<uint32_t>();
+
+    u.strike = (flags & HasStrike) ? std::optional(Price::fromRaw(strike)) : std::nullopt;
+    u.expiry = (flags & HasExpiry) ? std::optional(detail::timeFromNs(expiry)) : std::nullopt;
+    u.optionType = (flags & HasOptionType) ? std::optional(optionType) : std::nullopt;
+
+    u.bids.clear();
+    u.asks.clear();
+    u.bids.reserve(bids);
+    u.asks.reserve(asks);
+    for (uint32_t i = 0; i < bids + asks; ++i)
+    {
+      const auto price = Price::fromRaw(in.get<int64_t>());
+      const auto qty = Quantity::fromRaw(in.get<int64_t>());
+      (i < bids ? u.bids : u.asks).emplace_back(price, qty);
+    }
+    ev.tickSequence = rec.tickSequence;
+    ev.publishTsNs = static_cast<MonoNanos>(rec.publishNs);
+  }
+};
+
+template <>
+struct JournalCodec<CandleEvent>
+{
+  static constexpr JournalRecordType Type = JournalRecordType::Candle;
+
+  static uint32_t size(const CandleEvent&) { return 8 + 7 * 8; }
+  static int64_t publishNs(const CandleEvent&) { return 0; }  // candles carry no publish time
+
+  static void encode(const CandleEvent& ev, std::byte* p)
+  {
+    detail::JournalOut out{p};
+    out.put<uint32_t>(ev.symbol);
+    out.put<uint8_t>(static_cast<uint8_t>(ev.instrument));
+    out.put<uint8_t>(0);
+    out.put<uint16_t>(0);
+    out.put<int64_t>(ev.candle.open.raw());
+    out.put<int64_t>(ev.candle.high.raw());
+    out.put<int64_t>(ev.candle.low.raw());
+    out.put<int64_t>(ev.candle.close.raw());
+    out.put<int64_t>(ev.candle.volume.raw());
+    out.put<int64_t>(detail::timeNs(ev.candle.startTime));
+    out.put<int64_t>(detail::timeNs(ev.candle.endTime));
+  }
+
+  static void decode(const JournalRecordHeader& rec, std::span<const std::byte> payload, CandleEvent& ev)
+  {
+    detail::JournalIn in{payload.data()};
+    ev.symbol = in.get<uint32_t>();
+    ev.instrument = static_cast<InstrumentType>(in.get<uint8_t>());
+    in.get<uint8_t>();
+    in.get<uint16_t>();
+    ev.candle.open = Price::fromRaw(in.get<int64_t>());
+    ev.candle.high = Price::fromRaw(in.get<int64_t>());
+    ev.candle.low = Price::fromRaw(in.get<int64_t>());
+    ev.candle.close = Price::fromRaw(in.get<int64_t>());
+    ev.candle.volume = Volume::fromRaw(in.get<int64_t>());
+    ev.candle.startTime = detail::timeFromNs(in.get<int64_t>());
+    ev.candle.endTime = detail::timeFromNs(in.get<int64_t>());
+    ev.tickSequence = rec.tickSequence;
+  }
+};
+
+template <>
+struct JournalCodec<OrderEvent>
+{
+  static constexpr JournalRecordType Type = JournalRecordType::Order;
+
+  static constexpr uint32_t OrderBytes = 8 + 8 + 7 * 8;
+
+  enum : uint8_t
+  {
+    HasLastUpdated = 1,
+    HasExpiresAfter = 2,
+    HasExchangeTimestamp = 4
+  };
+
+  static uint32_t size(const OrderEvent&) { return 8 + 2 * OrderBytes + 3 * 8; }
+  static int64_t publishNs(const OrderEvent& ev) { return static_cast<int64_t>(ev.publishNs); }
+
+  static void encode(const OrderEvent& ev, std::byte* p)
+  {
+    detail::JournalOut out{p};
+    out.put<uint8_t>(static_cast<uint8_t>(ev.status));
+    out.put<uint8_t>(0);
+    out.put<uint16_t>(0);
+    out.put<uint32_t>(0);
+    encodeOrder(ev.order, out);
+    encodeOrder(ev.newOrder, out);
+    out.put<int64_t>(ev.fillQty.raw());
+    out.put<uint64_t>(ev.recvNs);
+    out.put<int64_t>(ev.exchangeTsNs);
+  }
+
+  static void decode(const JournalRecordHeader& rec, std::span<const std::byte> payload, OrderEvent& ev)
+  {
+    detail::JournalIn in{payload.data()};
+    ev.status = static_cast<OrderEventStatus>(in.get<uint8_t>());
+    in.get<uint8_t>();
+    in.get<uint16_t>();
+    in.get<uint32_t>();
+    decodeOrder(in, ev.order);
+    decodeOrder(in, ev.newOrder);
+    ev.fillQty = Quantity::fromRaw(in.get<int64_t>());
+    ev.recvNs = in.get<uint64_t>();
+    ev.exchangeTsNs = in.get<int64_t>();
+    ev.tickSequence = rec.tickSequence;
+    ev.publishNs = static_cast<uint64_t>(rec.publishNs);
+  }
+
+ private:
+  static void encodeOrder(const Order& o, detail::JournalOut& out)
+  {
+    out.put<uint64_t>(o.id);
+    out.put<uint8_t>(static_cast<uint8_t>(o.side));
+    out.put<uint8_t>(static_cast<uint8_t>(o.type));
+    out.put<uint8_t>((o.lastUpdated ? HasLastUpdated : 0) | (o.expiresAfter ? HasExpiresAfter : 0) |
+                     (o.exchangeTimestamp ? HasExchangeTimestamp : 0));
+    out.put<uint8_t>(0);
+    out.put<uint32_t>(o.symbol);
+    out.put<int64_t>(o.price.raw());
+    out.put<int64_t>(o.quantity.raw());
+    out.put<int64_t>(o.filledQuantity.raw());
+    out.put<int64_t>(detail::timeNs(o.createdAt));
+    out.put<int64_t>(o.lastUpdated ? detail::timeNs(*o.lastUpdated) : 0);
+    out.put<int64_t>(o.expiresAfter ? detail::timeNs(*o.expiresAfter) : 0);
+    out.put<int64_t>(o.exchangeTimestamp ? detail::timeNs(*o.exchangeTimestamp) : 0);
+  }
+
+  static void decodeOrder(detail::JournalIn& in, Order& o)
+  {
+    o.id = in.get<uint64_t>();
+    o.side = static_cast<Side>(in.get<uint8_t>());
+    o.type = static_cast<OrderType>(in.get<uint8_t>());
+    const uint8_t flags = in.get<uint8_t>();
+    in.get<uint8_t>();
+    o.symbol = in.get<uint32_t>();
+    o.price = Price::fromRaw(in.get<int64_t>());
+    o.quantity = Quantity::fromRaw(in.get<int64_t>());
+    o.filledQuantity = Quantity::fromRaw(in.get<int64_t>());
+    o.createdAt = detail::timeFromNs(in.get<int64_t>());
+    const int64_t lastUpdated = in.get<int64_t>();
+    const int64_t expiresAfter = in.get<int64_t>();
+    const int64_t exchangeTimestamp = in.get<int64_t>();
+    o.lastUpdated = (flags & HasLastUpdated) ? std::optional(detail::timeFromNs(lastUpdated)) : std::nullopt;
+    o.expiresAfter = (flags & HasExpiresAfter) ? std::optional(detail::timeFromNs(expiresAfter)) : std::nullopt;
+    o.exchangeTimestamp =
+        (flags & HasExchangeTimestamp) ? std::optional(detail::timeFromNs(exchangeTimestamp)) : std::nullopt;
+  }
+};
+
+// Append one event to `writer` without committing it
+template <typename Event>
+void journalAppend(JournalWriter& writer, const Event& ev)
+{
+  using Codec = JournalCodec<Event>;
+  const uint32_t size = Codec::size(ev);
+  Codec::encode(ev, writer.reserve(Codec::Type, ev.tickSequence, Codec::publishNs(ev), size));
+}
+
+/**
+ * Journaling consumer for TradeBus, BookUpdateBus and CandleBus.
+ *
+ * Subscribe it as an optional consumer so it never holds back the publisher. It writes
+ * each batch the bus hands it into the journal and commits once per batch. If it falls
+ * so far behind that the publisher laps it, the bus moves it ahead to events still in the
+ * ring; the skipped ones leave a gap in the recorded tickSequence and count as `lost` in
+ * the bus stats.
+ * One instance per bus: the journal is written from the consumer thread only.
+ */
+class MarketDataJournal final : public IMarketDataSubscriber
+{
+ public:
+  MarketDataJournal(SubscriberId id, std::filesystem::path directory, std::string name,
+                    size_t segmentBytes = JournalWriter::DefaultSegmentBytes)
+      : _id(id), _writer(std::move(directory), std::move(name), segmentBytes)
+  {
+  }
+
+  SubscriberId id() const override { return _id; }
+
+  void onTrade(const TradeEvent& ev) override { write(std::span(&ev, 1)); }
+  void onCandle(const CandleEvent& ev) override { write(std::span(&ev, 1)); }
+  void onBookUpdate(const BookUpdateEvent& ev) override
+  {
+    journalAppend(_writer, ev);
+    _writer.commit();
+  }
+
+  bool onTradeBatch(std::span<const TradeEvent> batch) override { return write(batch); }
+  bool onCandleBatch(std::span<const CandleEvent> batch) override { return write(batch); }
+  bool onBookUpdateBatch(std::span<const pool::Handle<BookUpdateEvent>> batch) override
+  {
+    FLOX_PROFILE_SCOPE("MarketDataJournal::write");
+    for (const auto& ev : batch)
+    {
+      journalAppend(_writer, *ev);
+    }
+    _writer.commit();
+    return true;
+  }
+
+  const JournalWriter& writer() const { return _writer; }
+
+ private:
+  template <typename Event>
+  bool write(std::span<const Event> batch)
+  {
+    FLOX_PROFILE_SCOPE("MarketDataJournal::write");
+    for (const auto& ev : batch)
+    {
+      journalAppend(_writer, ev);
+    }
+    _writer.commit();
+    return true;
+  }
+
+  SubscriberId _id;
+  JournalWriter _writer;
+};
+
+// Journaling consumer for OrderExecutionBus, with the same rules as MarketDataJournal
+class OrderEventJournal final : public IOrderExecutionListener
+{
+ public:
+  OrderEventJournal(SubscriberId id, std::filesystem::path directory, std::string name,
+                    size_t segmentBytes = JournalWriter::DefaultSegmentBytes)
+      : IOrderExecutionListener(id), _writer(std::move(directory), std::move(name), segmentBytes)
+  {
+  }
+
+  bool onOrderEvent(const OrderEvent& ev) override { return onOrderEventBatch(std::span(&ev, 1)); }
+
+  bool onOrderEventBatch(std::span<const OrderEvent> batch) override
+  {
+    FLOX_PROFILE_SCOPE("OrderEventJournal::write");
+    for (const auto& ev : batch)
+    {
+      journalAppend(_writer, ev);
+    }
+    _writer.commit();
+    return true;
+  }
+
+  // Not reached through EventDispatcher: onOrderEvent() takes every event first
+  void onOrderSubmitted(const Order&) override {}
+  void onOrderAccepted(const Order&) override {}
+  void onOrderPartiallyFilled(const Order&, Quantity) override {}
+  void onOrderFilled(const Order&) override {}
+  void onOrderCanceled(const Order&) override {}
+  void onOrderExpired(const Order&) override {}
+  void onOrderRejected(const Order&, const std::string&) override {}
+  void onOrderReplaced(const Order&, const Order&) override {}
+
+  const JournalWriter& writer() const { return _writer; }
+
+ private:
+  JournalWriter _writer;
+};
+
+}  // namespace flox
@@ -0,0 +1,351 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/engine/abstract_subsystem.h"
+#include "flox/engine/engine_config.h"
+#include "flox/engine/event_dispatcher.h"
+#include "flox/util/concurrency/wait_strategy.h"
+#include "flox/util/eventing/event_bus.h"
+#include "flox/util/performance/busy_backoff.h"
+#include "flox/util/performance/profile.h"
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace flox
+{
+
+/**
+ * Bus that keeps only the latest event per symbol.
+ *
+ * Publishing overwrites the symbol's slot and marks it dirty for every consumer. A
+ * consumer thread walks its dirty bitmap and sees each dirty symbol once, in its latest
+ * version, together with the number of versions it never saw. After a stall it catches
+ * up in O(symbols) instead of O(events).
+ *
+ * Only events that carry the full state of their symbol, such as book snapshots or
+ * top-of-book, may be conflated; deltas would be lost.
+ */
+template <typename Event, size_t MaxConsumers = config::DEFAULT_EVENTBUS_MAX_CONSUMERS>
+class ConflatingEventBus : public ISubsystem
+{
+  static_assert(requires(const Event& ev) { EventDispatcher<Event>::symbolOf(ev); },
+                "Event type carries no symbol to conflate on");
+
+ public:
+  using Listener = typename ListenerType<Event>::type;
+
+  struct ConsumerStats
+  {
+    Listener* listener{nullptr};
+    uint64_t delivered{0};  // callbacks, at most one per dirty symbol and pass
+    uint64_t conflated{0};  // versions overwritten before this consumer saw them
+  };
+
+  struct Stats
+  {
+    size_t symbols{0};
+    uint64_t published{0};
+    uint64_t rejected{0};  // events dropped because their symbol is not below `symbols`
+    std::vector<ConsumerStats> consumers;
+  };
+
+  // Symbols must be below `maxSymbols`; events for others are dropped and counted
+  explicit ConflatingEventBus(size_t maxSymbols)
+      : _symbols(maxSymbols),
+        _words((maxSymbols + 63) / 64),
+        _slots(std::make_unique<Slot[]>(maxSymbols)),
+        _consumers(std::make_unique<Consumer[]>(MaxConsumers))
+  {
+  }
+
+  ~ConflatingEventBus() { stop(); }
+
+  ConflatingEventBus(const ConflatingEventBus&) = delete;
+  ConflatingEventBus& operator=(const ConflatingEventBus&) = delete;
+
+  // Register a consumer before start(); it first sees every symbol published so far
+  void subscribe(Listener* listener, std::optional<WaitStrategy> waitStrategy = std::nullopt)
+  {
+    assert(listener && "Listener must not be null");
+    assert(!_running.load(std::memory_order_acquire) && "subscribe before start()");
+    std::lock_guard control(_controlMutex);
+
+    const uint32_t idx = _consumerCount.load(std::memory_order_relaxed);
+    assert(idx < MaxConsumers && "MaxConsumers limit exceeded");
+
+    auto& c = _consumers[idx];
+    c.listener = listener;
+    c.waitStrategy = waitStrategy;
+    c.dirty = std::make_unique<std::atomic<uint64_t>[]>(_words);
+    c.seen.assign(_symbols, 0);
+    for (size_t s = 0; s < _symbols; ++s)
+    {
+      lock(_slots[s]);
+      if (_slots[s].version != 0)
+      {
+        c.dirty[s / 64].fetch_or(uint64_t{1} << (s % 64), std::memory_order_relaxed);
+      }
+      unlock(_slots[s]);
+    }
+    _consumerCount.store(idx + 1, std::memory_order_release);
+  }
+
+  void setWaitStrategy(const WaitStrategy& strategy) { _waitStrategy = strategy; }
+
+  void start() override
+  {
+    std::lock_guard control(_controlMutex);
+    if (_running.exchange(true, std::memory_order_acq_rel))
+    {
+      return;
+    }
+
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    bool anyParks = false;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      anyParks |= _consumers[i].waitStrategy.value_or(_waitStrategy).parks();
+    }
+    _wakeConsumers.store(anyParks, std::memory_order_release);
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      launch(i);
+    }
+  }
+
+  // Slots keep their latest events, so a later start() resumes where this one left off
+  void stop() override
+  {
+    std::lock_guard control(_controlMutex);
+    if (!_running.exchange(false, std::memory_order_acq_rel))
+    {
+      return;
+    }
+    _signal.notifyAll();
+
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      _consumers[i].thread.reset();
+    }
+  }
+
+  // Safe from several threads; updates of one symbol are ordered by its slot lock
+  void publish(const Event& ev) { do_publish(ev); }
+  void publish(Event&& ev) { do_publish(std::move(ev)); }
+
+  // Block until every consumer has seen the latest version of everything published so far
+  void flush()
+  {
+    const uint64_t target = _published.load(std::memory_order_acquire);
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    Waiter waiter(_waitStrategy);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      while (_running.load(std::memory_order_acquire) &&
+             _consumers[i].synced.load(std::memory_order_acquire) < target)
+      {
+        waiter.pause();
+      }
+    }
+  }
+
+  uint32_t consumerCount() const { return _consumerCount.load(std::memory_order_acquire); }
+  size_t symbolCapacity() const { return _symbols; }
+
+  // Snapshot of bus activity, safe to call from any thread; fields are not mutually consistent
+  Stats stats() const
+  {
+    Stats out;
+    out.symbols = _symbols;
+    out.published = _published.load(std::memory_order_relaxed);
+    out.rejected = _rejected.load(std::memory_order_relaxed);
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      const auto& c = _consumers[i];
+      out.consumers.push_back(ConsumerStats{
+          .listener = c.listener,
+          .delivered = c.delivered.load(std::memory_order_relaxed),
+          .conflated = c.conflated.load(std::memory_order_relaxed),
+      });
+    }
+    return out;
+  }
+
+ private:
+  struct alignas(64) Slot
+  {
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    uint64_t version{0};  // updates published for this symbol, guarded by `lock`
+    std::optional<Event> value{};
+  };
+
+  struct Consumer
+  {
+    Listener* listener{nullptr};
+    std::optional<WaitStrategy> waitStrategy{};
+    std::unique_ptr<std::atomic<uint64_t>[]> dirty{};  // one bit per symbol
+    std::vector<uint64_t> seen{};                      // last delivered version, consumer thread only
+    alignas(64) std::atomic<uint64_t> synced{0};       // publishes fully delivered
+    std::atomic<uint64_t> delivered{0};
+    std::atomic<uint64_t> conflated{0};
+    std::optional<std::jthread> thread{};
+  };
+
+  static void lock(Slot& slot)
+  {
+    BusyBackoff bo;
+    while (slot.lock.test_and_set(std::memory_order_acquire))
+    {
+      bo.pause();
+    }
+  }
+
+  static void unlock(Slot& slot) { slot.lock.clear(std::memory_order_release); }
+
+  template <typename Ev>
+  void do_publish(Ev&& ev)
+  {
+    FLOX_PROFILE_SCOPE("Conflating::publish");
+
+    const size_t sym = EventDispatcher<Event>::symbolOf(ev);
+    if (sym >= _symbols) [[unlikely]]
+    {
+      _rejected.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    auto& slot = _slots[sym];
+    lock(slot);
+    slot.value.emplace(std::forward<Ev>(ev));
+    ++slot.version;
+    unlock(slot);
+
+    // Bits are set before the count moves, so a consumer that read the count finds them
+    const uint64_t bit = uint64_t{1} << (sym % 64);
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      _consumers[i].dirty[sym / 64].fetch_or(bit, std::memory_order_release);
+    }
+    _published.fetch_add(1, std::memory_order_release);
+
+    if (_wakeConsumers.load(std::memory_order_relaxed))
+    {
+      _signal.notifyAll();
+    }
+  }
+
+  void launch(uint32_t i)
+  {
+    auto strategy = _consumers[i].waitStrategy.value_or(_waitStrategy);
+    _consumers[i].thread.emplace([this, i, strategy]
+                                 {
+      auto& self = _consumers[i];
+      Waiter waiter(strategy, &_signal);
+
+      while (_running.load(std::memory_order_acquire))
+      {
+        const uint64_t target = _published.load(std::memory_order_acquire);
+        const bool found = drain(self);
+        self.synced.store(target, std::memory_order_release);
+
+        if (found)
+        {
+          waiter.reset();
+          continue;
+        }
+        waiter.pause([&]
+                     { return _published.load(std::memory_order_acquire) != target ||
+                              !_running.load(std::memory_order_acquire); });
+      } });
+  }
+
+  // One pass over the dirty bitmap; returns whether anything was delivered
+  bool drain(Consumer& c)
+  {
+    bool found = false;
+    for (size_t w = 0; w < _words; ++w)
+    {
+      if (c.dirty[w].load(std::memory_order_relaxed) == 0)
+      {
+        continue;
+      }
+      uint64_t bits = c.dirty[w].exchange(0, std::memory_order_acquire);
+      while (bits)
+      {
+        const size_t sym = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+        bits &= bits - 1;
+        found |= deliver(c, sym);
+      }
+    }
+    return found;
+  }
+
+  bool deliver(Consumer& c, size_t sym)
+  {
+    FLOX_PROFILE_SCOPE("Conflating::deliver");
+
+    auto& slot = _slots[sym];
+    lock(slot);
+    const uint64_t version = slot.version;
+    if (version == c.seen[sym])
+    {
+      unlock(slot);  // already delivered by an earlier pass
+      return false;
+    }
+    std::optional<Event> latest;
+    latest.emplace(*slot.value);
+    unlock(slot);
+
+    const uint64_t skipped = version - c.seen[sym] - 1;
+    c.seen[sym] = version;
+    if constexpr (requires { EventDispatcher<Event>::dispatchConflated(*latest, skipped, *c.listener); })
+    {
+      EventDispatcher<Event>::dispatchConflated(*latest, skipped, *c.listener);
+    }
+    else
+    {
+      EventDispatcher<Event>::dispatch(*latest, *c.listener);
+    }
+
+    c.delivered.store(c.delivered.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    c.conflated.store(c.conflated.load(std::memory_order_relaxed) + skipped, std::memory_order_relaxed);
+    return true;
+  }
+
+  const size_t _symbols;
+  const size_t _words;
+  std::unique_ptr<Slot[]> _slots;
+  std::unique_ptr<Consumer[]> _consumers;
+
+  alignas(64) std::atomic<uint64_t> _published{0};
+  std::atomic<uint64_t> _rejected{0};
+  alignas(64) std::atomic<bool> _running{false};
+  std::atomic<uint32_t> _consumerCount{0};
+
+  std::mutex _controlMutex;  // subscribe/start/stop
+  WaitStrategy _waitStrategy{};
+  ParkingSignal _signal;
+  std::atomic<bool> _wakeConsumers{false};
+};
+
+}  // namespace flox
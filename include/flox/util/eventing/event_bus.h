@@ -10,20 +10,30 @@
 #pragma once
 
 #include <algorithm>
-#include <array>
 #include <atomic>
+#include <bit>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <new>
 #include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "flox/engine/abstract_subsystem.h"
 #include "flox/engine/engine_config.h"
 #include "flox/engine/event_dispatcher.h"
+#include "flox/util/base/time.h"
+#include "flox/util/concurrency/wait_strategy.h"
+#include "flox/util/eventing/symbol_filter.h"
+#include "flox/util/memory/mapped_region.h"
 #include "flox/util/memory/pool.h"
 #include "flox/util/performance/busy_backoff.h"
 #include "flox/util/performance/profile.h"
@@ -46,18 +56,44 @@ struct ListenerType<pool::Handle<T>>
   using type = typename T::Listener;
 };
 
+// Any number of threads may publish; sequences are claimed with fetch_add
+struct MultiProducer
+{
+  static constexpr bool Single = false;
+};
+
+// Exactly one thread publishes; sequences come from a plain counter and slots
+// carry no per-slot construction flags
+struct SingleProducer
+{
+  static constexpr bool Single = true;
+};
+
+// What publish() and publishBatch() do when a required consumer holds back the ring
+enum class BusOverflowPolicy
+{
+  Block,        // wait for ring space
+  DropNewest,   // drop the event being published
+  EvictLagging  // after a grace period, demote the slowest gating consumer to optional
+};
+
 template <typename Event,
           size_t CapacityPow2 = config::DEFAULT_EVENTBUS_CAPACITY,
-          size_t MaxConsumers = config::DEFAULT_EVENTBUS_MAX_CONSUMERS>
+          size_t MaxConsumers = config::DEFAULT_EVENTBUS_MAX_CONSUMERS,
+          typename ProducerPolicy = MultiProducer>
 class EventBus : public ISubsystem
 {
   static_assert(CapacityPow2 > 0, "Capacity must be > 0");
   static_assert((CapacityPow2 & (CapacityPow2 - 1)) == 0, "Capacity must be power of 2");
-  static constexpr size_t Mask = CapacityPow2 - 1;
+  static constexpr bool SingleProducerMode = ProducerPolicy::Single;
+  static constexpr size_t MaxLappedBatch = 16;
 
  public:
   using Listener = typename ListenerType<Event>::type;
 
+  // Consumers can filter by symbol when the dispatcher knows how to read one
+  static constexpr bool HasSymbol = requires(const Event& ev) { EventDispatcher<Event>::symbolOf(ev); };
+
 #if FLOX_CPU_AFFINITY_ENABLED
   enum class ComponentType
   {
@@ -82,63 +118,1051 @@ class EventBus : public ISubsystem
   };
 #endif
 
-  struct ConsumerSlot
+  struct ConsumerOptions
+  {
+    bool required{true};                        // influence on gating
+    std::optional<WaitStrategy> waitStrategy{};  // bus default when empty
+    std::vector<Listener*> dependsOn{};          // upstream consumers, already subscribed
+    std::optional<SymbolFilter> symbols{};       // every symbol when empty
+    Listener* group{nullptr};                    // share the thread of this subscribed consumer
+  };
+
+  // Written by the consumer thread only; stats() reads them from any thread
+  struct alignas(64) ConsumerCounters
+  {
+    std::atomic<uint64_t> dispatched{0};
+    std::atomic<uint64_t> skipped{0};  // sequences passed over without a callback
+    std::atomic<uint64_t> lost{0};     // sequences overwritten before a lapped consumer got to them
+    std::atomic<int64_t> maxLag{0};    // largest backlog taken in one batch
+
+    // `fanout` members each looked at `batch` events and took `delivered` of them in total
+    void record(int64_t batch, size_t fanout, size_t delivered) noexcept
+    {
+      const auto n = static_cast<uint64_t>(batch) * fanout;
+      dispatched.store(dispatched.load(std::memory_order_relaxed) + delivered, std::memory_order_relaxed);
+      skipped.store(skipped.load(std::memory_order_relaxed) + (n - delivered), std::memory_order_relaxed);
+      if (batch > maxLag.load(std::memory_order_relaxed))
+      {
+        maxLag.store(batch, std::memory_order_relaxed);
+      }
+    }
+
+    void addLost(int64_t n) noexcept
+    {
+      lost.store(lost.load(std::memory_order_relaxed) + static_cast<uint64_t>(n), std::memory_order_relaxed);
+    }
+
+    void reset() noexcept
+    {
+      dispatched.store(0, std::memory_order_relaxed);
+      skipped.store(0, std::memory_order_relaxed);
+      lost.store(0, std::memory_order_relaxed);
+      maxLag.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  struct Member
+  {
+    Listener* listener{nullptr};
+    std::optional<SymbolFilter> symbols{};
+  };
+
+  // Slots are reused after unsubscribe(); a free slot has no listener and sequence INT64_MAX.
+  // A slot is one thread and one gating sequence serving every listener in `members`.
+  struct ConsumerSlot
+  {
+    Listener* listener{nullptr};  // first member
+    bool required{true};          // influence on gating
+    std::optional<WaitStrategy> waitStrategy{};
+    std::vector<Member> members{};  // dispatch order
+    std::vector<uint32_t> upstream{};  // consumer indices this one trails
+    std::atomic<bool> hasDependents{false};  // some consumer trails this one
+    bool shadowed{false};              // a required dependent gates on its behalf
+    alignas(64) std::atomic<int64_t> seq{-1};  // last handled seq
+    std::atomic<bool> gates{false};            // publishes its seq into _gating
+    std::atomic<bool> attached{false};         // cleared to make the thread leave
+    std::atomic<bool> live{false};             // thread is running or draining
+    std::atomic<bool> lappable{false};         // nothing gates on its behalf: publishers may lap it
+    std::atomic<int64_t> reading{INT64_MAX};   // first sequence of the batch a lappable consumer reads
+    bool evicted{false};                       // demoted by BusOverflowPolicy::EvictLagging
+    ConsumerCounters counters{};
+    std::optional<std::jthread> thread{};
+  };
+
+  struct ConsumerStats
+  {
+    Listener* listener{nullptr};  // first member of the group
+    size_t members{1};
+    bool required{true};
+    bool evicted{false};     // stopped gating after lagging a full ring under EvictLagging
+    int64_t seq{-1};         // last handled sequence
+    int64_t lag{0};          // published cursor minus seq
+    int64_t maxLag{0};       // largest backlog taken in one batch
+    uint64_t dispatched{0};  // events handed to members, summed over members
+    uint64_t skipped{0};     // events a member passed over, e.g. by its symbol filter
+    uint64_t lost{0};        // events overwritten before this consumer got to them
+  };
+
+  struct Stats
+  {
+    size_t capacity{0};
+    int64_t cursor{-1};          // highest claimed (multi-producer) or committed sequence
+    int64_t occupancy{0};        // sequences the slowest gating consumer has yet to handle
+    uint64_t publishStalls{0};   // times a publisher had to wait for ring space
+    uint64_t publishStallNs{0};  // total time spent in those waits
+    uint64_t dropped{0};         // events discarded under DropNewest
+    uint64_t rejected{0};        // tryPublish() calls that found the ring full
+    uint64_t evictions{0};       // consumers demoted under EvictLagging
+    std::vector<ConsumerStats> consumers;
+  };
+
+  // Contiguous range of sequences reserved by claim(); becomes visible on commit()
+  struct Claim
+  {
+    int64_t first{0};
+    int64_t last{-1};
+
+    size_t size() const noexcept { return static_cast<size_t>(last - first + 1); }
+  };
+
+ public:
+  EventBus() : EventBus(EventBusConfig{}) {}
+
+  /**
+   * @brief Create a bus whose ring is sized and placed at runtime
+   *
+   * The ring (slots plus sequence flags) lives in one mapped region that can be backed
+   * by huge pages and bound to a NUMA node; `config.capacity == 0` uses CapacityPow2.
+   * Throws std::invalid_argument if the capacity is not a power of two.
+   */
+  explicit EventBus(const EventBusConfig& config)
+      : _capacity(checkedCapacity(config.capacity ? config.capacity : CapacityPow2)),
+        _mask(_capacity - 1),
+        _consumers(std::make_unique<ConsumerSlot[]>(MaxConsumers)),
+        _gating(std::make_unique<std::atomic<int64_t>[]>(MaxConsumers))
+#if FLOX_CPU_AFFINITY_ENABLED
+        ,
+        _cpuAffinity(performance::createCpuAffinity())
+#endif
+  {
+    // Slots, then published sequences, then construction flags, each block line-aligned
+    const size_t slotBytes = (_capacity * sizeof(Storage) + 63) & ~size_t{63};
+    const size_t publishedBytes = (_capacity * sizeof(std::atomic<int64_t>) + 63) & ~size_t{63};
+    const size_t constructedBytes = SingleProducerMode ? 0 : _capacity * sizeof(std::atomic<uint8_t>);
+    _ring = MappedRegion(slotBytes + publishedBytes + constructedBytes,
+                         MemoryPlacement{.hugePages = config.hugePages, .numaNode = config.numaNode});
+
+    auto* base = static_cast<std::byte*>(_ring.data());
+    _storage = reinterpret_cast<Storage*>(base);
+    _published = reinterpret_cast<std::atomic<int64_t>*>(base + slotBytes);
+    for (size_t i = 0; i < _capacity; ++i)
+    {
+      ::new (&_published[i]) std::atomic<int64_t>(-1);
+    }
+    if constexpr (!SingleProducerMode)
+    {
+      _constructed = reinterpret_cast<std::atomic<uint8_t>*>(base + slotBytes + publishedBytes);
+      for (size_t i = 0; i < _capacity; ++i)
+      {
+        ::new (&_constructed[i]) std::atomic<uint8_t>(0);
+      }
+    }
+  }
+
+  ~EventBus() { stop(); }
+
+  EventBus(const EventBus&) = delete;
+  EventBus& operator=(const EventBus&) = delete;
+
+  void subscribe(Listener* listener, bool required = true)
+  {
+    subscribe(listener, ConsumerOptions{.required = required});
+  }
+
+  // Only events for `symbols` reach the listener; the rest are skipped before dispatch
+  void subscribe(Listener* listener, SymbolFilter symbols)
+  {
+    subscribe(listener, ConsumerOptions{.symbols = std::move(symbols)});
+  }
+
+  /**
+   * @brief Register a consumer; allowed while the bus is running
+   *
+   * A consumer added to a running bus starts at the current cursor: it sees events
+   * published from now on and gates the publisher from its first sequence.
+   * With `options.group` the listener joins that consumer's thread instead; see joinGroup().
+   */
+  void subscribe(Listener* listener, const ConsumerOptions& options)
+  {
+    assert(listener && "Listener must not be null");
+    assert((!options.symbols || HasSymbol) && "Event type carries no symbol to filter on");
+    std::lock_guard control(_controlMutex);
+
+    if (options.group)
+    {
+      joinGroup(listener, options);
+      return;
+    }
+
+    const uint32_t count = _consumerCount.load(std::memory_order_relaxed);
+    uint32_t idx = 0;
+    while (idx < count && _consumers[idx].listener != nullptr)
+    {
+      ++idx;
+    }
+    assert(idx < MaxConsumers && "MaxConsumers limit exceeded");
+
+    auto& slot = _consumers[idx];
+    const bool running = _running.load(std::memory_order_acquire);
+    slot.listener = listener;
+    slot.required = options.required;
+    slot.waitStrategy = options.waitStrategy;
+    slot.members.assign(1, Member{listener, options.symbols});
+    slot.upstream.clear();
+    slot.hasDependents.store(false, std::memory_order_relaxed);
+    slot.shadowed = false;
+    slot.evicted = false;
+    slot.reading.store(INT64_MAX, std::memory_order_relaxed);
+    slot.counters.reset();
+
+    // Upstreams must already be subscribed and nobody can depend on the new consumer yet,
+    // so the dependency graph cannot have cycles
+    for (Listener* dep : options.dependsOn)
+    {
+      const uint32_t j = indexOf(dep);
+      assert(j < count && j != idx && "dependsOn must name a subscribed consumer");
+      slot.upstream.push_back(j);
+      _consumers[j].hasDependents.store(true, std::memory_order_release);
+
+      // A required consumer never passes its upstreams, so its gating sequence covers
+      // theirs. Running upstreams keep gating: they may be storing a sequence right now.
+      if (options.required && !running)
+      {
+        _consumers[j].shadowed = true;
+        _consumers[j].gates.store(false, std::memory_order_relaxed);
+        _gating[j].store(INT64_MAX, std::memory_order_relaxed);
+        setLappable(j, false);
+      }
+    }
+
+    // Start at the cursor so earlier sequences are neither awaited nor kept alive.
+    // Outstanding claims were checked against older gating values, which never exceed it.
+    const int64_t start = publishedCursor();
+    slot.seq.store(start, std::memory_order_seq_cst);
+    slot.gates.store(options.required, std::memory_order_relaxed);
+    setLappable(idx, !options.required);
+    _gating[idx].store(options.required ? start : INT64_MAX, std::memory_order_seq_cst);
+    if (idx == count)
+    {
+      _consumerCount.store(count + 1, std::memory_order_release);
+    }
+    _subscribed.fetch_add(1, std::memory_order_release);
+
+    if (running)
+    {
+      if (slot.waitStrategy.value_or(_waitStrategy).parks())
+      {
+        _wakeConsumers.store(true, std::memory_order_release);
+      }
+      launchAndWait(idx);
+    }
+  }
+
+  /**
+   * @brief Remove a consumer; allowed while the bus is running
+   *
+   * The consumer stops gating the publisher at once; its thread finishes the current
+   * batch and exits. A member of a larger group leaves it without releasing the group's
+   * gating sequence. Must not be called from the consumer's own callbacks.
+   * @return false if the listener is not subscribed
+   */
+  bool unsubscribe(Listener* listener)
+  {
+    std::lock_guard control(_controlMutex);
+
+    const uint32_t idx = indexOf(listener);
+    if (listener == nullptr || idx == _consumerCount.load(std::memory_order_relaxed))
+    {
+      return false;
+    }
+    auto& slot = _consumers[idx];
+
+    if (slot.members.size() > 1)
+    {
+      // The thread owns its copy of the member list; swap it while the thread is away
+      detach(idx);
+      std::erase_if(slot.members, [&](const Member& m)
+                    { return m.listener == listener; });
+      slot.listener = slot.members.front().listener;
+      _subscribed.fetch_sub(1, std::memory_order_release);
+      if (_running.load(std::memory_order_acquire))
+      {
+        launchAndWait(idx);
+      }
+      return true;
+    }
+    assert(!slot.hasDependents.load(std::memory_order_relaxed) && "unsubscribe dependent consumers first");
+
+    // Upstreams this consumer gated for must gate for themselves again before the
+    // publisher stops seeing this consumer's sequence
+    slot.listener = nullptr;
+    for (uint32_t j : slot.upstream)
+    {
+      refreshDependents(j);
+    }
+
+    slot.gates.store(false, std::memory_order_relaxed);
+    _gating[idx].store(INT64_MAX, std::memory_order_seq_cst);
+    _subscribed.fetch_sub(1, std::memory_order_release);
+
+    detach(idx);
+    setLappable(idx, false);
+    // The thread may have loaded `gates` just before it was cleared and stored one more
+    // gating sequence; it is joined now, so this store is the last
+    _gating[idx].store(INT64_MAX, std::memory_order_seq_cst);
+
+    slot.members.clear();
+    slot.upstream.clear();
+    slot.seq.store(INT64_MAX, std::memory_order_release);
+    tryReclaim();
+    return true;
+  }
+
+  /**
+   * @brief Set how idle threads of this bus wait; call before start()
+   *
+   * Applies to consumers subscribed without their own strategy and to publishers waiting
+   * for ring space. Publishers are never signalled, so a parking strategy makes them sleep
+   * in parkTimeout steps.
+   */
+  void setWaitStrategy(const WaitStrategy& strategy) { _waitStrategy = strategy; }
+  const WaitStrategy& waitStrategy() const { return _waitStrategy; }
+
+  /**
+   * @brief Set what publishers do when the ring is full; call before start()
+   *
+   * DropNewest applies to publish() and publishBatch(); claim() has to hand out
+   * sequences and still blocks. Under EvictLagging a publisher that has waited
+   * `evictAfter` demotes the slowest gating consumer, which may be lapped from then on.
+   */
+  void setOverflowPolicy(BusOverflowPolicy policy,
+                         std::chrono::nanoseconds evictAfter = std::chrono::milliseconds{1})
+  {
+    _overflow = policy;
+    _evictAfter = evictAfter;
+  }
+  BusOverflowPolicy overflowPolicy() const { return _overflow; }
+
+  void start() override
+  {
+    std::lock_guard control(_controlMutex);
+    if (_running.exchange(true, std::memory_order_acq_rel))
+    {
+      return;
+    }
+
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+
+    // Publishers and upstream consumers only pay for wakeups when some consumer may be parked
+    uint32_t active = 0;
+    bool anyParks = false;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      if (_consumers[i].listener)
+      {
+        ++active;
+        anyParks |= _consumers[i].waitStrategy.value_or(_waitStrategy).parks();
+      }
+    }
+    _active.store(active, std::memory_order_relaxed);
+    _wakeConsumers.store(anyParks, std::memory_order_release);
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      if (_consumers[i].listener)
+      {
+        launch(i);
+      }
+    }
+
+    std::unique_lock lk(_readyMutex);
+    _cv.wait(lk, [&]
+             { return _active.load(std::memory_order_acquire) == 0; });
+  }
+
+  void stop() override
+  {
+    std::lock_guard control(_controlMutex);
+    if (!_running.exchange(false, std::memory_order_acq_rel))
+    {
+      return;
+    }
+    _signal.notifyAll();
+
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      _consumers[i].thread.reset();
+      _consumers[i].reading.store(INT64_MAX, std::memory_order_relaxed);
+    }
+
+    if constexpr (SingleProducerMode)
+    {
+      // Everything committed past the reclaim watermark is still live
+      reclaim(_cursor.load(std::memory_order_acquire), true);
+      for (size_t i = 0; i < _capacity; ++i)
+      {
+        _published[i].store(-1, std::memory_order_relaxed);
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < _capacity; ++i)
+      {
+        if (_constructed[i].exchange(0, std::memory_order_acq_rel))
+        {
+          slot_ptr(i)->~Event();
+        }
+        _published[i].store(-1, std::memory_order_relaxed);
+      }
+      _reclaimSeq.store(-1, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns the event's sequence, or -1 if BusOverflowPolicy::DropNewest dropped it
+  int64_t publish(const Event& ev) { return do_publish(ev); }
+  int64_t publish(Event&& ev) { return do_publish(std::move(ev)); }
+
+  // Never waits: returns -1 if the ring is full, whatever the overflow policy
+  int64_t tryPublish(const Event& ev) { return do_try_publish(ev); }
+  int64_t tryPublish(Event&& ev) { return do_try_publish(std::move(ev)); }
+
+  // Construct the event directly in its ring slot from `args`; otherwise like publish()
+  template <typename... Args>
+  int64_t emplace(Args&&... args)
+  {
+    return do_publish(std::forward<Args>(args)...);
+  }
+
+  // Construct the event directly in its ring slot from `args`; otherwise like tryPublish()
+  template <typename... Args>
+  int64_t tryEmplace(Args&&... args)
+  {
+    return do_try_publish(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Publish a batch of events with one claim and one commit per ring-sized chunk
+   *
+   * Under BusOverflowPolicy::DropNewest the first chunk that does not fit is dropped
+   * together with the rest of the batch.
+   * @return Sequence of the last published event, or -1 if nothing was published
+   */
+  int64_t publishBatch(std::span<const Event> events)
+  {
+    FLOX_PROFILE_SCOPE("Disruptor::publishBatch");
+
+    int64_t last = -1;
+    while (!events.empty())
+    {
+      const size_t n = std::min(events.size(), _capacity);
+      Claim c;
+      if (_overflow == BusOverflowPolicy::DropNewest)
+      {
+        const auto tried = tryClaim(n);
+        if (!tried)
+        {
+          _dropped.fetch_add(events.size(), std::memory_order_relaxed);
+          break;
+        }
+        c = *tried;
+      }
+      else
+      {
+        c = claim(n);
+      }
+      for (size_t i = 0; i < n; ++i)
+      {
+        emplaceAt(c.first + static_cast<int64_t>(i), events[i]);
+      }
+      commit(c);
+
+      last = c.last;
+      events = events.subspan(n);
+    }
+    return last;
+  }
+
+  /**
+   * @brief Reserve n consecutive sequences, waiting until the ring has room for all of them
+   *
+   * Every sequence of the claim must be constructed with emplaceAt() before commit().
+   * Consumers stall on an uncommitted claim, so keep the window between the two short.
+   */
+  Claim claim(size_t n)
+  {
+    FLOX_PROFILE_SCOPE("Disruptor::claim");
+    assert(n > 0 && n <= _capacity && "Claim size must be in [1, Capacity]");
+
+    const int64_t count = static_cast<int64_t>(n);
+    int64_t last;
+    if constexpr (SingleProducerMode)
+    {
+      last = _next.load(std::memory_order_relaxed) + count;
+      _next.store(last, std::memory_order_relaxed);
+    }
+    else
+    {
+      last = _next.fetch_add(count, std::memory_order_acq_rel) + count;
+    }
+    waitForCapacity(last);
+    return reserve(last - count + 1, last);
+  }
+
+  /**
+   * @brief Reserve n consecutive sequences only if the ring has room for all of them now
+   * @return The claim, or nothing if the slowest gating consumer is too close behind
+   */
+  std::optional<Claim> tryClaim(size_t n)
+  {
+    FLOX_PROFILE_SCOPE("Disruptor::tryClaim");
+    assert(n > 0 && n <= _capacity && "Claim size must be in [1, Capacity]");
+
+    const int64_t count = static_cast<int64_t>(n);
+    int64_t last;
+    if constexpr (SingleProducerMode)
+    {
+      last = _next.load(std::memory_order_relaxed) + count;
+      if (!hasCapacity(last))
+      {
+        return std::nullopt;
+      }
+      _next.store(last, std::memory_order_relaxed);
+    }
+    else
+    {
+      int64_t cur = _next.load(std::memory_order_relaxed);
+      do
+      {
+        last = cur + count;
+        if (!hasCapacity(last))
+        {
+          return std::nullopt;
+        }
+      } while (!_next.compare_exchange_weak(cur, last, std::memory_order_acq_rel, std::memory_order_relaxed));
+    }
+    return reserve(last - count + 1, last);
+  }
+
+  // Construct the event for a claimed sequence directly in its ring slot
+  template <typename... Args>
+  Event& emplaceAt(int64_t seq, Args&&... args)
+  {
+    const size_t idx = size_t(seq) & _mask;
+
+    Event* ev = ::new (slot_ptr(idx)) Event(std::forward<Args>(args)...);
+    if constexpr (!SingleProducerMode)
+    {
+      _constructed[idx].store(1, std::memory_order_release);
+    }
+
+    stampTickSequence(*ev, seq);
+    return *ev;
+  }
+
+  // Make a whole claim visible to consumers: one release fence, then plain stores per slot
+  void commit(const Claim& c)
+  {
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int64_t s = c.first; s <= c.last; ++s)
+    {
+      const size_t idx = size_t(s) & _mask;
+      assert(slotLive(idx) && "Committing an unconstructed slot");
+      _published[idx].store(s, std::memory_order_relaxed);
+    }
+    if constexpr (SingleProducerMode)
+    {
+      _cursor.store(c.last, std::memory_order_release);
+    }
+    if (_wakeConsumers.load(std::memory_order_relaxed))
+    {
+      _signal.notifyAll();
+    }
+
+    tryReclaim();
+  }
+
+  void waitConsumed(int64_t seq)
+  {
+    FLOX_PROFILE_SCOPE("Disruptor::waitConsumed");
+    Waiter waiter(_waitStrategy);
+    while (_running.load(std::memory_order_acquire) && minGating() < seq)
+    {
+      waiter.pause();
+    }
+  }
+
+  void flush()
+  {
+    waitConsumed(publishedCursor());
+  }
+
+  uint32_t consumerCount() const { return _subscribed.load(std::memory_order_acquire); }
+
+  bool isSubscribed(const Listener* listener) const
+  {
+    std::lock_guard control(_controlMutex);
+    return listener && indexOf(listener) < _consumerCount.load(std::memory_order_relaxed);
+  }
+  size_t capacity() const { return _capacity; }
+
+  /**
+   * @brief Snapshot of bus health, safe to call from any thread
+   *
+   * Counters are updated with plain relaxed stores by their owning thread, so the
+   * snapshot costs the hot path nothing; its fields are not mutually consistent.
+   */
+  Stats stats() const
+  {
+    Stats out;
+    out.capacity = _capacity;
+    out.cursor = publishedCursor();
+    out.occupancy = std::max<int64_t>(0, out.cursor - minGating());
+    out.publishStalls = _publishStalls.load(std::memory_order_relaxed);
+    out.publishStallNs = _publishStallNs.load(std::memory_order_relaxed);
+    out.dropped = _dropped.load(std::memory_order_relaxed);
+    out.rejected = _rejected.load(std::memory_order_relaxed);
+    out.evictions = _evictions.load(std::memory_order_relaxed);
+
+    std::lock_guard control(_controlMutex);
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      const auto& c = _consumers[i];
+      if (!c.listener)
+      {
+        continue;
+      }
+      const int64_t seq = c.seq.load(std::memory_order_acquire);
+      out.consumers.push_back(ConsumerStats{
+          .listener = c.listener,
+          .members = c.members.size(),
+          .required = c.required && !c.evicted,
+          .evicted = c.evicted,
+          .seq = seq,
+          .lag = std::max<int64_t>(0, out.cursor - seq),
+          .maxLag = c.counters.maxLag.load(std::memory_order_relaxed),
+          .dispatched = c.counters.dispatched.load(std::memory_order_relaxed),
+          .skipped = c.counters.skipped.load(std::memory_order_relaxed),
+          .lost = c.counters.lost.load(std::memory_order_relaxed),
+      });
+    }
+    return out;
+  }
+
+  bool hugePageBacked() const { return _ring.hugePages(); }
+  void enableDrainOnStop() { _drainOnStop = true; }
+
+#if FLOX_CPU_AFFINITY_ENABLED
+  // ---------- CPU Affinity / RT priority ----------
+  void setAffinityConfig(const AffinityConfig& cfg)
+  {
+    _affinityConfig = cfg;
+
+    performance::CriticalComponentConfig coreCfg;
+    coreCfg.preferIsolatedCores = cfg.preferIsolatedCores;
+    coreCfg.exclusiveIsolatedCores = true;
+    coreCfg.allowSharedCriticalCores = false;
+
+    if (cfg.enableNumaAwareness)
+    {
+      _coreAssignment = _cpuAffinity->getNumaAwareCoreAssignment(coreCfg);
+    }
+    else
+    {
+      _coreAssignment = _cpuAffinity->getRecommendedCoreAssignment(coreCfg);
+    }
+  }
+
+  void setCoreAssignment(const performance::CoreAssignment& assignment)
+  {
+    _coreAssignment = assignment;
+    _affinityConfig = AffinityConfig{ComponentType::GENERAL, config::DEFAULT_REALTIME_PRIORITY};
+  }
+
+  std::optional<performance::CoreAssignment> getCoreAssignment() const { return _coreAssignment; }
+  std::optional<AffinityConfig> getAffinityConfig() const { return _affinityConfig; }
+
+  bool setupOptimalConfiguration(ComponentType componentType, bool enablePerformanceOptimizations = false)
+  {
+    AffinityConfig cfg;
+    cfg.componentType = componentType;
+    cfg.enableRealTimePriority = (componentType != ComponentType::GENERAL);
+    cfg.enableNumaAwareness = true;
+    cfg.preferIsolatedCores = true;
+
+    switch (componentType)
+    {
+      case ComponentType::MARKET_DATA:
+        cfg.realTimePriority = config::MARKET_DATA_PRIORITY;
+        break;
+      case ComponentType::EXECUTION:
+        cfg.realTimePriority = config::EXECUTION_PRIORITY;
+        break;
+      case ComponentType::STRATEGY:
+        cfg.realTimePriority = config::STRATEGY_PRIORITY;
+        break;
+      case ComponentType::RISK:
+        cfg.realTimePriority = config::RISK_PRIORITY;
+        break;
+      case ComponentType::GENERAL:
+        cfg.realTimePriority = config::GENERAL_PRIORITY;
+        break;
+    }
+    setAffinityConfig(cfg);
+
+    if (enablePerformanceOptimizations)
+    {
+      _cpuAffinity->disableCpuFrequencyScaling();
+    }
+    return _coreAssignment.has_value();
+  }
+
+  bool verifyIsolatedCoreConfiguration() const
+  {
+    if (!_coreAssignment.has_value())
+    {
+      return false;
+    }
+    return _cpuAffinity->verifyCriticalCoreIsolation(_coreAssignment.value());
+  }
+#endif
+
+ private:
+  template <typename... Args>
+  int64_t do_publish(Args&&... args)
+  {
+    FLOX_PROFILE_SCOPE("Disruptor::publish");
+
+    if (_overflow == BusOverflowPolicy::DropNewest)
+    {
+      const auto c = tryClaim(1);
+      if (!c)
+      {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+      }
+      emplaceAt(c->first, std::forward<Args>(args)...);
+      commit(*c);
+      return c->first;
+    }
+
+    const Claim c = claim(1);
+    emplaceAt(c.first, std::forward<Args>(args)...);
+    commit(c);
+
+    return c.first;
+  }
+
+  template <typename... Args>
+  int64_t do_try_publish(Args&&... args)
+  {
+    FLOX_PROFILE_SCOPE("Disruptor::tryPublish");
+
+    const auto c = tryClaim(1);
+    if (!c)
+    {
+      _rejected.fetch_add(1, std::memory_order_relaxed);
+      return -1;
+    }
+    emplaceAt(c->first, std::forward<Args>(args)...);
+    commit(*c);
+    return c->first;
+  }
+
+  // Free the slots of [first, last], which the caller has claimed and found room for
+  Claim reserve(int64_t first, int64_t last)
+  {
+    const int64_t wrap = last - static_cast<int64_t>(_capacity);
+    if (_lappable.load(std::memory_order_relaxed) != 0)
+    {
+      waitForReaders(wrap);
+    }
+
+    // Slots up to the reclaim watermark are already destroyed. Forcing the watermark
+    // forward only happens when an optional consumer is being lapped; it must move
+    // past the overwritten sequences so a later reclaim never destroys their successors.
+    if (_reclaimSeq.load(std::memory_order_acquire) < wrap)
+    {
+      reclaim(wrap, true);
+    }
+
+    return Claim{first, last};
+  }
+
+  // Wait until no lappable consumer reads a sequence at or below `wrap`. Pairs with the
+  // fence in pin(): either the reader sees this claim and skips the slot, or this side
+  // sees the reader's pin and waits out its batch.
+  void waitForReaders(int64_t wrap)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      BusyBackoff bo;
+      while (_consumers[i].reading.load(std::memory_order_acquire) <= wrap)
+      {
+        bo.pause();
+      }
+    }
+  }
+
+  bool hasCapacity(int64_t last)
+  {
+    const int64_t wrap = last - static_cast<int64_t>(_capacity);
+    int64_t cachedMin = _cachedMin.load(std::memory_order_relaxed);
+    if (wrap <= cachedMin)
+    {
+      return true;
+    }
+    cachedMin = minGating();
+    _cachedMin.store(cachedMin, std::memory_order_relaxed);
+    return wrap <= cachedMin;
+  }
+
+  void waitForCapacity(int64_t last)
+  {
+    const int64_t wrap = last - static_cast<int64_t>(_capacity);
+
+    int64_t cachedMin = _cachedMin.load(std::memory_order_relaxed);
+    if (wrap <= cachedMin)
+    {
+      return;
+    }
+
+    Waiter waiter(_waitStrategy);
+    int64_t stallStart = 0;
+    int64_t evictAt = 0;
+    while (wrap > cachedMin)
+    {
+      cachedMin = minGating();
+      _cachedMin.store(cachedMin, std::memory_order_relaxed);
+      if (wrap <= cachedMin)
+      {
+        break;
+      }
+      if (stallStart == 0)
+      {
+        stallStart = nowNsMonotonic();
+        evictAt = stallStart + _evictAfter.count();
+      }
+      else if (_overflow == BusOverflowPolicy::EvictLagging && nowNsMonotonic() >= evictAt && evictLagging(wrap))
+      {
+        // Give the next slowest consumer a full grace period of its own
+        evictAt = nowNsMonotonic() + _evictAfter.count();
+        continue;
+      }
+      waiter.pause();
+    }
+
+    if (stallStart != 0)
+    {
+      _publishStalls.fetch_add(1, std::memory_order_relaxed);
+      _publishStallNs.fetch_add(static_cast<uint64_t>(nowNsMonotonic() - stallStart), std::memory_order_relaxed);
+    }
+  }
+
+  // Stop the slowest consumer gating below `wrap` from holding back publishers. Its
+  // upstreams gate for themselves again if it was gating on their behalf. Returns false
+  // if another thread holds the control mutex; the caller waits and retries.
+  bool evictLagging(int64_t wrap)
+  {
+    std::unique_lock control(_controlMutex, std::try_to_lock);
+    if (!control.owns_lock())
+    {
+      return false;
+    }
+
+    const uint32_t n = _consumerCount.load(std::memory_order_relaxed);
+    uint32_t slowest = n;
+    int64_t lowest = wrap;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      const int64_t g = _gating[i].load(std::memory_order_acquire);
+      if (g < lowest)
+      {
+        lowest = g;
+        slowest = i;
+      }
+    }
+    if (slowest == n)
+    {
+      return true;  // someone caught up meanwhile
+    }
+
+    // The consumer may store one more gating value it loaded `gates` for; the next
+    // pass finds it again and only clears it
+    auto& c = _consumers[slowest];
+    if (!c.evicted)
+    {
+      c.evicted = true;
+      _evictions.fetch_add(1, std::memory_order_relaxed);
+      for (uint32_t j : c.upstream)
+      {
+        refreshDependents(j);
+      }
+    }
+    // From its next batch on it is lapped like an optional consumer; the batch it is
+    // stuck in was taken unpinned, so its slots may be overwritten underneath it
+    c.gates.store(false, std::memory_order_relaxed);
+    setLappable(slowest, true);
+    _gating[slowest].store(INT64_MAX, std::memory_order_seq_cst);
+    return true;
+  }
+
+  // Sequences map to slots through a mask, which only works for a power of two
+  static size_t checkedCapacity(size_t capacity)
   {
-    Listener* listener{nullptr};
-    bool required{true};                       // influence on gating
-    alignas(64) std::atomic<int64_t> seq{-1};  // last handled seq
-    std::optional<std::jthread> thread{};
-  };
+    if (!std::has_single_bit(capacity))
+    {
+      throw std::invalid_argument("EventBus: capacity " + std::to_string(capacity) + " is not a power of two");
+    }
+    return capacity;
+  }
 
- public:
-  EventBus()
-#if FLOX_CPU_AFFINITY_ENABLED
-      : _cpuAffinity(performance::createCpuAffinity())
-#endif
+  static void stampTickSequence(Event& obj, int64_t seq)
   {
-    for (auto& p : _published)
+    if constexpr (requires { obj->tickSequence; })
     {
-      p.store(-1, std::memory_order_relaxed);
+      obj->tickSequence = static_cast<uint64_t>(seq);
     }
-    for (auto& c : _constructed)
+    if constexpr (requires { obj.tickSequence; })
     {
-      c.store(0, std::memory_order_relaxed);
+      obj.tickSequence = static_cast<uint64_t>(seq);
     }
   }
 
-  ~EventBus() { stop(); }
+  int64_t minGating() const
+  {
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    int64_t mn = INT64_MAX;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      const int64_t s = _gating[i].load(std::memory_order_acquire);
+      mn = s < mn ? s : mn;
+    }
+    return (mn == INT64_MAX) ? publishedCursor() : mn;
+  }
 
-  EventBus(const EventBus&) = delete;
-  EventBus& operator=(const EventBus&) = delete;
+  // Lowest sequence handled by every consumer, optional ones included: a slot may only be
+  // destroyed once nobody can still be reading it
+  int64_t minConsumed() const
+  {
+    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
+    int64_t mn = INT64_MAX;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      const int64_t s = _consumers[i].seq.load(std::memory_order_acquire);
+      mn = s < mn ? s : mn;
+    }
+    return (mn == INT64_MAX) ? publishedCursor() : mn;
+  }
 
-  void subscribe(Listener* listener, bool required = true)
+  // Highest sequence in the contiguous published run starting at `from`, which must
+  // itself be published. Bounded by one ring length.
+  int64_t highestPublished(int64_t from) const
   {
-    assert(listener && "Listener must not be null");
-    const uint32_t idx = _consumerCount.fetch_add(1, std::memory_order_acq_rel);
-    assert(idx < MaxConsumers && "MaxConsumers limit exceeded");
-    _consumers[idx].listener = listener;
-    _consumers[idx].required = required;
-    _consumers[idx].seq.store(-1, std::memory_order_relaxed);
-    _gating[idx].store(required ? -1 : INT64_MAX, std::memory_order_relaxed);
+    const int64_t limit = from + static_cast<int64_t>(_capacity) - 1;
+    if constexpr (SingleProducerMode)
+    {
+      const int64_t cursor = _cursor.load(std::memory_order_acquire);
+      return std::clamp(cursor, from, limit);
+    }
+    else
+    {
+      int64_t hi = from;
+      while (hi < limit && _published[size_t(hi + 1) & _mask].load(std::memory_order_acquire) == hi + 1)
+      {
+        ++hi;
+      }
+      return hi;
+    }
   }
 
-  void start() override
+  // Slot holding `listener` as any of its members; _consumerCount if there is none
+  uint32_t indexOf(const Listener* listener) const
   {
-    if (_running.exchange(true, std::memory_order_acq_rel))
+    const uint32_t count = _consumerCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i)
     {
-      return;
+      const auto& members = _consumers[i].members;
+      if (_consumers[i].listener &&
+          std::any_of(members.begin(), members.end(), [&](const Member& m)
+                      { return m.listener == listener; }))
+      {
+        return i;
+      }
     }
+    return count;
+  }
 
-    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
-    _active.store(n, std::memory_order_relaxed);
+  // Add `listener` to the thread and gating sequence of `options.group`. The group keeps
+  // its own required flag, wait strategy and upstreams; the member brings its symbol filter.
+  // On a running bus the group's thread is joined and relaunched from its last sequence,
+  // so the new member starts right after the batch the group was handling.
+  void joinGroup(Listener* listener, const ConsumerOptions& options)
+  {
+    const uint32_t idx = indexOf(options.group);
+    assert(idx < _consumerCount.load(std::memory_order_relaxed) && "group must name a subscribed consumer");
+    assert(options.dependsOn.empty() && "group members share the group's upstreams");
+    assert(indexOf(listener) == _consumerCount.load(std::memory_order_relaxed) && "listener is already subscribed");
+
+    detach(idx);
+    _consumers[idx].members.push_back(Member{listener, options.symbols});
+    _subscribed.fetch_add(1, std::memory_order_release);
+    if (_running.load(std::memory_order_acquire))
+    {
+      launchAndWait(idx);
+    }
+  }
 
-    for (uint32_t i = 0; i < n; ++i)
+  // Make the thread of consumer `i` leave without draining; its gating sequence stays put
+  void detach(uint32_t i)
+  {
+    _consumers[i].attached.store(false, std::memory_order_release);
+    _signal.notifyAll();
+    _consumers[i].thread.reset();
+  }
+
+  void launchAndWait(uint32_t i)
+  {
+    _active.store(1, std::memory_order_relaxed);
+    launch(i);
+    std::unique_lock lk(_readyMutex);
+    _cv.wait(lk, [&]
+             { return _active.load(std::memory_order_acquire) == 0; });
+  }
+
+  // Hand [from, to] to every member in turn; returns the number of events delivered
+  size_t deliverGroup(const std::vector<Member>& members, int64_t from, int64_t to)
+  {
+    size_t delivered = 0;
+    for (const auto& m : members)
     {
-      auto* l = _consumers[i].listener;
-      auto required = _consumers[i].required;
+      delivered += deliver(*m.listener, from, to, m.symbols ? &*m.symbols : nullptr);
+    }
+    return delivered;
+  }
+
+  // Spawn the thread of consumer `i`; the caller waits on _cv for it to report ready
+  void launch(uint32_t i)
+  {
+    auto strategy = _consumers[i].waitStrategy.value_or(_waitStrategy);
 
-      _consumers[i].thread.emplace([this, i, l, required]
-                                   {
+    _consumers[i].attached.store(true, std::memory_order_relaxed);
+    _consumers[i].live.store(true, std::memory_order_relaxed);
+    _consumers[i].thread.emplace([this, i, strategy, members = _consumers[i].members]
+                                 {
 #if FLOX_CPU_AFFINITY_ENABLED
          auto threadCpuAffinity = performance::createCpuAffinity();
          if (_coreAssignment.has_value() && _affinityConfig.has_value())
@@ -186,279 +1210,392 @@ class EventBus : public ISubsystem
            if (_active.fetch_sub(1, std::memory_order_acq_rel) == 1) _cv.notify_one();
          }
  
-         BusyBackoff backoff;
-         int64_t next = -1;
+         auto& self = _consumers[i];
+         Waiter waiter(strategy, &_signal);
+         int64_t next = self.seq.load(std::memory_order_relaxed);
  
-         while (_running.load(std::memory_order_acquire))
+         while (attached(self))
          {
-           const int64_t seq = next + 1;
-           const size_t  idx = size_t(seq) & Mask;
+           int64_t seq = next + 1;
+           const bool lappable = self.lappable.load(std::memory_order_acquire);
+           auto ready = [&]
+           {
+             return isAvailable(self, seq) || (lappable && lapped(seq, lappedBatch())) || !attached(self);
+           };
  
-           while (_published[idx].load(std::memory_order_acquire) != seq)
+           for (;;)
            {
-             if (!_running.load(std::memory_order_relaxed)) break;
-             backoff.pause();
+             if (lappable)
+             {
+               seq = skipLapped(self, seq);
+             }
+             if (isAvailable(self, seq) || !attached(self)) break;
+             waiter.pause(ready);
            }
-           if (!_running.load(std::memory_order_relaxed)) break;
+           if (!attached(self)) break;
  
-           if (!required && _constructed[idx].load(std::memory_order_acquire) == 0)
+           // Take everything that is already available, then gate and reclaim once
+           int64_t last = availableUpTo(self, seq);
+           if (lappable)
            {
-             // skip
+             // A publisher that wraps onto the batch waits for it, so keep it short
+             last = std::min(last, seq + lappedBatch() - 1);
+             if (!pin(self, seq))
+             {
+               next = seq - 1;
+               continue;
+             }
            }
-           else
            {
              FLOX_PROFILE_SCOPE("Disruptor::deliver");
-             EventDispatcher<Event>::dispatch(slot_ref(idx), *l);
+             self.counters.record(last - seq + 1, members.size(), deliverGroup(members, seq, last));
            }
  
-           _consumers[i].seq.store(seq, std::memory_order_release);
-           _gating[i].store(required ? seq : INT64_MAX, std::memory_order_release);
- 
-           tryReclaim();
+           advance(i, last);
+           if (lappable)
+           {
+             self.reading.store(INT64_MAX, std::memory_order_release);
+           }
 
-           next = seq;
-           backoff.reset();
+           next = last;
+           waiter.reset();
          }
  
-         if (_drainOnStop)
+         // A consumer leaving through unsubscribe() does not drain
+         if (_drainOnStop && self.attached.load(std::memory_order_acquire))
          {
-           int64_t seq = _consumers[i].seq.load(std::memory_order_relaxed);
+           int64_t seq = self.seq.load(std::memory_order_relaxed);
+           if (self.lappable.load(std::memory_order_acquire))
+           {
+             seq = skipLapped(self, seq + 1) - 1;
+           }
            for (;;)
            {
              const int64_t want = seq + 1;
-             const size_t  idx  = size_t(want) & Mask;
+             const size_t  idx  = size_t(want) & _mask;
              if (_published[idx].load(std::memory_order_acquire) != want) break;
- 
-             if (!required && _constructed[idx].load(std::memory_order_acquire) == 0)
+
+             // Published but held back by an upstream that is still draining
+             if (!isAvailable(self, want))
              {
-               // skip
+               if (upstreamLive(self))
+               {
+                 cpuRelax();
+                 continue;
+               }
+               // Upstreams are done; their final sequences are visible now
+               if (!isAvailable(self, want)) break;
              }
-             else
+ 
+             const int64_t last = availableUpTo(self, want);
              {
                FLOX_PROFILE_SCOPE("Disruptor::drain_deliver");
-               EventDispatcher<Event>::dispatch(slot_ref(idx), *l);
+               self.counters.record(last - want + 1, members.size(), deliverGroup(members, want, last));
              }
  
-             _consumers[i].seq.store(want, std::memory_order_release);
-             _gating[i].store(required ? want : INT64_MAX, std::memory_order_release);
-
-             tryReclaim();
+             advance(i, last);
 
-             seq = want;
+             seq = last;
            }
-         } });
-    }
+         }
 
-    std::unique_lock lk(_readyMutex);
-    _cv.wait(lk, [&]
-             { return _active.load(std::memory_order_acquire) == 0; });
+         self.live.store(false, std::memory_order_release); });
   }
 
-  void stop() override
+  // Lowest sequence handled by every upstream of `c`; INT64_MAX without upstreams
+  int64_t upstreamSeq(const ConsumerSlot& c) const
   {
-    if (!_running.exchange(false, std::memory_order_acq_rel))
+    int64_t lo = INT64_MAX;
+    for (uint32_t j : c.upstream)
     {
-      return;
+      lo = std::min(lo, _consumers[j].seq.load(std::memory_order_acquire));
     }
+    return lo;
+  }
 
-    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
-    for (uint32_t i = 0; i < n; ++i)
+  bool upstreamLive(const ConsumerSlot& c) const
+  {
+    return std::any_of(c.upstream.begin(), c.upstream.end(), [this](uint32_t j)
+                       { return _consumers[j].live.load(std::memory_order_acquire); });
+  }
+
+  // `seq` is published and every upstream of `c` has handled it
+  bool isAvailable(const ConsumerSlot& c, int64_t seq) const
+  {
+    return _published[size_t(seq) & _mask].load(std::memory_order_acquire) == seq &&
+           (c.upstream.empty() || upstreamSeq(c) >= seq);
+  }
+
+  // Highest sequence `c` may handle in one batch starting at an available `from`
+  int64_t availableUpTo(const ConsumerSlot& c, int64_t from) const
+  {
+    const int64_t last = highestPublished(from);
+    return c.upstream.empty() ? last : std::min(last, upstreamSeq(c));
+  }
+
+  // Largest batch a lappable consumer takes at once
+  int64_t lappedBatch() const
+  {
+    return static_cast<int64_t>(std::clamp<size_t>(_capacity / 64, 1, MaxLappedBatch));
+  }
+
+  // Publishers have claimed the slot of `seq` for a later sequence, or will have after
+  // `margin` more claims
+  bool lapped(int64_t seq, int64_t margin = 0) const
+  {
+    return _next.load(std::memory_order_acquire) - seq >= static_cast<int64_t>(_capacity) - margin;
+  }
+
+  // A consumer that is lapped, or less than a batch from it, moves on to newer events,
+  // keeping half a ring of headroom; otherwise it and the publisher would take turns
+  // one batch at a time. The sequences passed over count as lost. Returns the sequence
+  // to read next.
+  int64_t skipLapped(ConsumerSlot& c, int64_t seq)
+  {
+    if (!lapped(seq, lappedBatch()))
     {
-      _consumers[i].thread.reset();
+      return seq;
     }
-
-    for (size_t i = 0; i < CapacityPow2; ++i)
+    int64_t resume = _next.load(std::memory_order_acquire) - static_cast<int64_t>(_capacity / 2) + 1;
+    if (!c.upstream.empty())
     {
-      if (_constructed[i].exchange(0, std::memory_order_acq_rel))
-      {
-        slot_ptr(i)->~Event();
-      }
-      _published[i].store(-1, std::memory_order_relaxed);
+      resume = std::min(resume, upstreamSeq(c) + 1);
+    }
+    if (resume <= seq)
+    {
+      return seq;  // an upstream is lapped as well and skips first
     }
-    _reclaimSeq.store(-1, std::memory_order_relaxed);
+    c.counters.addLost(resume - seq);
+    c.seq.store(resume - 1, std::memory_order_release);
+    return resume;
   }
 
-  int64_t publish(const Event& ev) { return do_publish(ev); }
-  int64_t publish(Event&& ev) { return do_publish(std::move(ev)); }
-
-  void waitConsumed(int64_t seq)
+  // Announce that `c` reads from `from` on; false if a publisher already claimed that slot
+  bool pin(ConsumerSlot& c, int64_t from)
   {
-    FLOX_PROFILE_SCOPE("Disruptor::waitConsumed");
-    BusyBackoff bo;
-    while (_running.load(std::memory_order_acquire) && minGating() < seq)
+    c.reading.store(from, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!lapped(from))
     {
-      bo.pause();
+      return true;
     }
+    c.reading.store(INT64_MAX, std::memory_order_release);
+    return false;
   }
 
-  void flush()
+  // Consumer `j` no longer gates, and nothing gates on its behalf, or the reverse
+  void setLappable(uint32_t j, bool on)
   {
-    const int64_t last = _next.load(std::memory_order_acquire);
-    waitConsumed(last);
+    if (_consumers[j].lappable.exchange(on, std::memory_order_acq_rel) != on)
+    {
+      _lappable.fetch_add(on ? 1u : static_cast<uint32_t>(-1), std::memory_order_acq_rel);
+    }
   }
 
-  uint32_t consumerCount() const { return _consumerCount.load(std::memory_order_acquire); }
-  void enableDrainOnStop() { _drainOnStop = true; }
-
-#if FLOX_CPU_AFFINITY_ENABLED
-  // ---------- CPU Affinity / RT priority ----------
-  void setAffinityConfig(const AffinityConfig& cfg)
+  // Recompute whether consumer `j` still has dependents and still needs no gating of its own
+  void refreshDependents(uint32_t j)
   {
-    _affinityConfig = cfg;
-
-    performance::CriticalComponentConfig coreCfg;
-    coreCfg.preferIsolatedCores = cfg.preferIsolatedCores;
-    coreCfg.exclusiveIsolatedCores = true;
-    coreCfg.allowSharedCriticalCores = false;
+    auto& up = _consumers[j];
+    bool dependents = false;
+    bool shadowed = false;
+    const uint32_t count = _consumerCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const auto& c = _consumers[i];
+      if (c.listener && std::find(c.upstream.begin(), c.upstream.end(), j) != c.upstream.end())
+      {
+        dependents = true;
+        shadowed |= c.required && !c.evicted;
+      }
+    }
+    up.hasDependents.store(dependents, std::memory_order_release);
 
-    if (cfg.enableNumaAwareness)
+    if (up.shadowed && !shadowed && !(up.required && !up.evicted))
     {
-      _coreAssignment = _cpuAffinity->getNumaAwareCoreAssignment(coreCfg);
+      up.shadowed = false;
+      setLappable(j, true);
     }
-    else
+    else if (up.shadowed && !shadowed)
     {
-      _coreAssignment = _cpuAffinity->getRecommendedCoreAssignment(coreCfg);
+      // Either the consumer thread sees `gates` and stores its gating sequence, or this
+      // side sees its latest sequence; the CAS never replaces a value the thread stored
+      up.shadowed = false;
+      up.gates.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t expected = INT64_MAX;
+      _gating[j].compare_exchange_strong(expected, up.seq.load(std::memory_order_relaxed),
+                                         std::memory_order_acq_rel);
     }
   }
 
-  void setCoreAssignment(const performance::CoreAssignment& assignment)
+  bool attached(const ConsumerSlot& c) const
   {
-    _coreAssignment = assignment;
-    _affinityConfig = AffinityConfig{ComponentType::GENERAL, config::DEFAULT_REALTIME_PRIORITY};
+    return _running.load(std::memory_order_acquire) && c.attached.load(std::memory_order_acquire);
   }
 
-  std::optional<performance::CoreAssignment> getCoreAssignment() const { return _coreAssignment; }
-  std::optional<AffinityConfig> getAffinityConfig() const { return _affinityConfig; }
-
-  bool setupOptimalConfiguration(ComponentType componentType, bool enablePerformanceOptimizations = false)
+  // Record progress of consumer `i`; wakes parked dependents, then reclaims
+  void advance(uint32_t i, int64_t last)
   {
-    AffinityConfig cfg;
-    cfg.componentType = componentType;
-    cfg.enableRealTimePriority = (componentType != ComponentType::GENERAL);
-    cfg.enableNumaAwareness = true;
-    cfg.preferIsolatedCores = true;
-
-    switch (componentType)
+    auto& c = _consumers[i];
+    c.seq.store(last, std::memory_order_release);
+    if (c.gates.load(std::memory_order_relaxed))
     {
-      case ComponentType::MARKET_DATA:
-        cfg.realTimePriority = config::MARKET_DATA_PRIORITY;
-        break;
-      case ComponentType::EXECUTION:
-        cfg.realTimePriority = config::EXECUTION_PRIORITY;
-        break;
-      case ComponentType::STRATEGY:
-        cfg.realTimePriority = config::STRATEGY_PRIORITY;
-        break;
-      case ComponentType::RISK:
-        cfg.realTimePriority = config::RISK_PRIORITY;
-        break;
-      case ComponentType::GENERAL:
-        cfg.realTimePriority = config::GENERAL_PRIORITY;
-        break;
+      _gating[i].store(last, std::memory_order_release);
+    }
+    else if (c.required)
+    {
+      // Shadowed: pairs with the fence in refreshDependents() when gating is handed back
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (c.gates.load(std::memory_order_relaxed))
+      {
+        _gating[i].store(last, std::memory_order_release);
+      }
     }
-    setAffinityConfig(cfg);
 
-    if (enablePerformanceOptimizations)
+    if (c.hasDependents.load(std::memory_order_relaxed) && _wakeConsumers.load(std::memory_order_relaxed))
     {
-      _cpuAffinity->disableCpuFrequencyScaling();
+      _signal.notifyAll();
     }
-    return _coreAssignment.has_value();
+
+    tryReclaim();
   }
 
-  bool verifyIsolatedCoreConfiguration() const
+  // Dispatch [from, to] as at most two contiguous spans, split where the ring wraps.
+  // With a filter, each span is further cut into runs of matching events.
+  // Returns the number of events handed to the listener.
+  size_t deliver(Listener& listener, int64_t from, int64_t to, const SymbolFilter* filter)
   {
-    if (!_coreAssignment.has_value())
+    size_t delivered = 0;
+    while (from <= to)
     {
-      return false;
+      const size_t idx = size_t(from) & _mask;
+      const size_t n = std::min(static_cast<size_t>(to - from + 1), _capacity - idx);
+      const Event* events = slot_ptr(idx);
+
+      if constexpr (HasSymbol)
+      {
+        if (filter)
+        {
+          size_t i = 0;
+          while (i < n)
+          {
+            while (i < n && !filter->contains(EventDispatcher<Event>::symbolOf(events[i])))
+            {
+              ++i;
+            }
+            const size_t run = i;
+            while (i < n && filter->contains(EventDispatcher<Event>::symbolOf(events[i])))
+            {
+              ++i;
+            }
+            if (i > run)
+            {
+              dispatchSpan(listener, events + run, i - run);
+              delivered += i - run;
+            }
+          }
+          from += static_cast<int64_t>(n);
+          continue;
+        }
+      }
+
+      dispatchSpan(listener, events, n);
+      delivered += n;
+      from += static_cast<int64_t>(n);
     }
-    return _cpuAffinity->verifyCriticalCoreIsolation(_coreAssignment.value());
+    return delivered;
   }
-#endif
 
- private:
-  template <typename Ev>
-  int64_t do_publish(Ev&& ev)
+  static void dispatchSpan(Listener& listener, const Event* events, size_t n)
   {
-    FLOX_PROFILE_SCOPE("Disruptor::publish");
-
-    const int64_t seq = _next.fetch_add(1, std::memory_order_acq_rel) + 1;
-    const int64_t wrap = seq - static_cast<int64_t>(CapacityPow2);
+    if (n == 1)
+    {
+      EventDispatcher<Event>::dispatch(*events, listener);
+      return;
+    }
 
-    BusyBackoff bo;
-    int64_t cachedMin = _cachedMin.load(std::memory_order_relaxed);
-    while (wrap > cachedMin)
+    const std::span<const Event> batch(events, n);
+    if constexpr (requires { EventDispatcher<Event>::dispatchBatch(batch, listener); })
     {
-      cachedMin = minGating();
-      _cachedMin.store(cachedMin, std::memory_order_relaxed);
-      if (wrap <= cachedMin)
+      EventDispatcher<Event>::dispatchBatch(batch, listener);
+    }
+    else
+    {
+      for (const auto& ev : batch)
       {
-        break;
+        EventDispatcher<Event>::dispatch(ev, listener);
       }
-      bo.pause();
     }
+  }
 
-    const size_t idx = size_t(seq) & Mask;
-
-    if (_constructed[idx].exchange(0, std::memory_order_acq_rel))
+  // Highest sequence whose event is fully constructed in the ring
+  int64_t publishedCursor() const
+  {
+    if constexpr (SingleProducerMode)
     {
-      slot_ptr(idx)->~Event();
+      return _cursor.load(std::memory_order_acquire);
     }
+    else
+    {
+      return _next.load(std::memory_order_acquire);
+    }
+  }
 
-    ::new (slot_ptr(idx)) Event(std::forward<Ev>(ev));
-    _constructed[idx].store(1, std::memory_order_release);
-
-    auto& obj = slot_ref(idx);
-    if constexpr (requires { obj->tickSequence; })
+  inline bool slotLive(size_t idx) const noexcept
+  {
+    if constexpr (SingleProducerMode)
     {
-      obj->tickSequence = static_cast<uint64_t>(seq);
+      return true;
     }
-    if constexpr (requires { obj.tickSequence; })
+    else
     {
-      obj.tickSequence = static_cast<uint64_t>(seq);
+      return _constructed[idx].load(std::memory_order_acquire) != 0;
     }
-
-    _published[idx].store(seq, std::memory_order_release);
-
-    tryReclaim();
-
-    return seq;
   }
 
-  int64_t minGating() const
+  inline void destroySlot(size_t idx)
   {
-    const uint32_t n = _consumerCount.load(std::memory_order_acquire);
-    int64_t mn = INT64_MAX;
-    for (uint32_t i = 0; i < n; ++i)
+    if constexpr (SingleProducerMode)
     {
-      const int64_t s = _gating[i].load(std::memory_order_acquire);
-      mn = s < mn ? s : mn;
+      slot_ptr(idx)->~Event();
+    }
+    else if (_constructed[idx].exchange(0, std::memory_order_acq_rel))
+    {
+      slot_ptr(idx)->~Event();
     }
-    return (mn == INT64_MAX) ? _next.load(std::memory_order_acquire) : mn;
   }
 
-  inline void tryReclaim()
+  inline void tryReclaim() { reclaim(minConsumed(), false); }
+
+  // Destroy every event up to `upto`. With `force` the caller waits for the reclaim lock
+  // instead of leaving the work to whoever holds it.
+  void reclaim(int64_t upto, bool force)
   {
-    const int64_t upto = minGating();
     int64_t cur = _reclaimSeq.load(std::memory_order_relaxed);
     if (upto <= cur)
     {
       return;
     }
 
-    if (_reclaimLock.test_and_set(std::memory_order_acquire))
+    if (force)
+    {
+      BusyBackoff bo;
+      while (_reclaimLock.test_and_set(std::memory_order_acquire))
+      {
+        bo.pause();
+      }
+    }
+    else if (_reclaimLock.test_and_set(std::memory_order_acquire))
     {
       return;
     }
+
     cur = _reclaimSeq.load(std::memory_order_relaxed);
     if (upto > cur)
     {
       for (int64_t s = cur + 1; s <= upto; ++s)
       {
-        const size_t idx = size_t(s) & Mask;
-        if (_constructed[idx].exchange(0, std::memory_order_acq_rel))
-        {
-          slot_ptr(idx)->~Event();
-        }
+        destroySlot(size_t(s) & _mask);
       }
 
       _reclaimSeq.store(upto, std::memory_order_release);
@@ -468,31 +1605,52 @@ class EventBus : public ISubsystem
   }
 
  private:
+  const size_t _capacity;
+  const size_t _mask;
+
   alignas(64) std::atomic<bool> _running{false};
   alignas(64) std::atomic<int64_t> _next{-1};
   alignas(64) std::atomic<int64_t> _cachedMin{-1};
+  alignas(64) std::atomic<int64_t> _cursor{-1};  // last committed seq, single producer only
 
   using Storage = std::aligned_storage_t<sizeof(Event), alignof(Event)>;
-  alignas(64) std::array<Storage, CapacityPow2> _storage{};
+  static_assert(sizeof(Storage) == sizeof(Event), "Slots must be contiguous to be delivered as spans");
+  MappedRegion _ring;
+  Storage* _storage{nullptr};
   inline Event* slot_ptr(size_t idx) noexcept { return std::launder(reinterpret_cast<Event*>(&_storage[idx])); }
   inline Event& slot_ref(size_t idx) noexcept { return *slot_ptr(idx); }
 
-  alignas(64) std::array<std::atomic<int64_t>, CapacityPow2> _published{};
-  alignas(64) std::array<std::atomic<uint8_t>, CapacityPow2> _constructed{};
+  std::atomic<int64_t>* _published{nullptr};
+  std::atomic<uint8_t>* _constructed{nullptr};  // multi-producer only
+
+  alignas(64) std::atomic<uint64_t> _publishStalls{0};
+  std::atomic<uint64_t> _publishStallNs{0};
+  std::atomic<uint64_t> _dropped{0};
+  std::atomic<uint64_t> _rejected{0};
+  std::atomic<uint64_t> _evictions{0};
 
   alignas(64) std::atomic<int64_t> _reclaimSeq{-1};
   alignas(64) std::atomic_flag _reclaimLock = ATOMIC_FLAG_INIT;
 
-  alignas(64) std::array<ConsumerSlot, MaxConsumers> _consumers{};
-  alignas(64) std::array<std::atomic<int64_t>, MaxConsumers> _gating{};
-  alignas(64) std::atomic<uint32_t> _consumerCount{0};
+  std::unique_ptr<ConsumerSlot[]> _consumers;
+  std::unique_ptr<std::atomic<int64_t>[]> _gating;
+  alignas(64) std::atomic<uint32_t> _consumerCount{0};  // slots in use or freed, scanned by gating
+  std::atomic<uint32_t> _subscribed{0};
+  std::atomic<uint32_t> _lappable{0};  // consumers publishers may lap; they check pins only then
 
   std::condition_variable _cv;
   std::mutex _readyMutex;
+  mutable std::mutex _controlMutex;  // subscribe/unsubscribe/start/stop, stats(), isSubscribed()
   std::atomic<uint32_t> _active{0};
 
   bool _drainOnStop{false};
 
+  WaitStrategy _waitStrategy{};
+  BusOverflowPolicy _overflow{BusOverflowPolicy::Block};
+  std::chrono::nanoseconds _evictAfter{std::chrono::milliseconds{1}};
+  ParkingSignal _signal;
+  std::atomic<bool> _wakeConsumers{false};
+
 #if FLOX_CPU_AFFINITY_ENABLED
   // CPU affinity / RT
   std::unique_ptr<performance::CpuAffinity> _cpuAffinity;
@@ -0,0 +1,333 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace flox
+{
+
+enum class JournalRecordType : uint16_t
+{
+  Trade = 1,
+  BookUpdate = 2,
+  Candle = 3,
+  Order = 4
+};
+
+// Precedes every payload; records start on 8-byte boundaries
+struct JournalRecordHeader
+{
+  uint32_t size{0};  // payload bytes, excluding this header and padding
+  JournalRecordType type{};
+  uint16_t reserved{0};
+  uint64_t tickSequence{0};
+  int64_t publishNs{0};
+};
+
+static_assert(sizeof(JournalRecordHeader) == 24);
+
+// First bytes of every segment file
+struct JournalSegmentHeader
+{
+  static constexpr char Magic[8] = {'F', 'L', 'O', 'X', 'J', 'N', 'L', '1'};
+
+  char magic[8]{};
+  uint32_t headerBytes{0};
+  uint32_t reserved{0};
+  uint64_t end{0};  // offset past the last committed record, written with release order
+  uint64_t records{0};
+};
+
+namespace detail
+{
+
+inline std::filesystem::path journalSegmentPath(const std::filesystem::path& dir, const std::string& name,
+                                                uint32_t index)
+{
+  char suffix[16];
+  std::snprintf(suffix, sizeof(suffix), ".%06u.jnl", index);
+  return dir / (name + suffix);
+}
+
+// Indices of the existing segments of `name` in `dir`, ascending
+inline std::vector<uint32_t> journalSegments(const std::filesystem::path& dir, const std::string& name)
+{
+  std::vector<uint32_t> out;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+  {
+    const std::string file = entry.path().filename().string();
+    unsigned index = 0;
+    char tail[8] = {};
+    if (file.size() == name.size() + 11 && file.compare(0, name.size(), name) == 0 &&
+        std::sscanf(file.c_str() + name.size(), ".%6u.%3s", &index, tail) == 2 && std::strcmp(tail, "jnl") == 0)
+    {
+      out.push_back(index);
+    }
+  }
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+}  // namespace detail
+
+/**
+ * Append-only journal made of memory-mapped segment files `<name>.NNNNNN.jnl`.
+ *
+ * Records are written straight into the mapping with reserve() and become visible to
+ * readers, and survive a crash of the process, at the next commit(). A new writer never
+ * touches existing segments; it continues with the next index. Single-threaded.
+ */
+class JournalWriter
+{
+ public:
+  static constexpr size_t DefaultSegmentBytes = 64u << 20;
+
+  JournalWriter(std::filesystem::path directory, std::string name, size_t segmentBytes = DefaultSegmentBytes)
+      : _dir(std::move(directory)), _name(std::move(name)), _segmentBytes(segmentBytes)
+  {
+    std::filesystem::create_directories(_dir);
+    const auto existing = detail::journalSegments(_dir, _name);
+    _nextIndex = existing.empty() ? 0 : existing.back() + 1;
+  }
+
+  ~JournalWriter() { closeSegment(); }
+
+  JournalWriter(const JournalWriter&) = delete;
+  JournalWriter& operator=(const JournalWriter&) = delete;
+
+  // Space for a `size`-byte payload; valid until the next reserve()
+  std::byte* reserve(JournalRecordType type, uint64_t tickSequence, int64_t publishNs, uint32_t size)
+  {
+    const size_t need = sizeof(JournalRecordHeader) + ((size_t(size) + 7) & ~size_t{7});
+    if (!_data || _pos + need > _size)
+    {
+      openSegment(need);
+    }
+
+    const JournalRecordHeader header{
+        .size = size, .type = type, .tickSequence = tickSequence, .publishNs = publishNs};
+    std::memcpy(_data + _pos, &header, sizeof(header));
+    std::byte* payload = _data + _pos + sizeof(header);
+    _pos += need;
+    ++_pending;
+    return payload;
+  }
+
+  // Make every record reserved so far visible to readers
+  void commit()
+  {
+    if (!_data || _pending == 0)
+    {
+      return;
+    }
+    auto* header = reinterpret_cast<JournalSegmentHeader*>(_data);
+    header->records += _pending;
+    std::atomic_ref<uint64_t>(header->end).store(_pos, std::memory_order_release);
+    _records += _pending;
+    _pending = 0;
+  }
+
+  uint64_t records() const { return _records; }
+  uint32_t segments() const { return _segments; }
+  const std::filesystem::path& directory() const { return _dir; }
+  const std::string& name() const { return _name; }
+
+ private:
+  void openSegment(size_t need)
+  {
+    commit();
+    closeSegment();
+
+#if defined(__linux__)
+    const auto path = detail::journalSegmentPath(_dir, _name, _nextIndex++);
+    const size_t bytes = std::max(_segmentBytes, sizeof(JournalSegmentHeader) + need);
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+    {
+      throw std::system_error(errno, std::generic_category(), "open " + path.string());
+    }
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+      const int err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::generic_category(), "ftruncate " + path.string());
+    }
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int err = errno;
+    if (p == MAP_FAILED)
+    {
+      ::close(fd);
+      throw std::system_error(err, std::generic_category(), "mmap " + path.string());
+    }
+
+    _fd = fd;
+    _data = static_cast<std::byte*>(p);
+    _size = bytes;
+    _pos = sizeof(JournalSegmentHeader);
+    ++_segments;
+
+    auto* header = ::new (_data) JournalSegmentHeader{};
+    std::memcpy(header->magic, JournalSegmentHeader::Magic, sizeof(header->magic));
+    header->headerBytes = sizeof(JournalSegmentHeader);
+    header->end = _pos;
+#else
+    (void)need;
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "journal");
+#endif
+  }
+
+  // Trims the segment to its committed length so a finished journal takes no extra space
+  void closeSegment()
+  {
+    if (!_data)
+    {
+      return;
+    }
+    commit();
+#if defined(__linux__)
+    const auto end = static_cast<off_t>(reinterpret_cast<JournalSegmentHeader*>(_data)->end);
+    munmap(_data, _size);
+    // On failure the segment keeps its zero tail; readers stop at `end` either way
+    [[maybe_unused]] const int rc = ftruncate(_fd, end);
+    ::close(_fd);
+#endif
+    _data = nullptr;
+    _fd = -1;
+  }
+
+  std::filesystem::path _dir;
+  std::string _name;
+  size_t _segmentBytes;
+  uint32_t _nextIndex{0};
+
+  int _fd{-1};
+  std::byte* _data{nullptr};
+  size_t _size{0};
+  size_t _pos{0};
+
+  uint64_t _pending{0};
+  uint64_t _records{0};
+  uint32_t _segments{0};
+};
+
+/**
+ * Sequential reader over the segments of a journal, e.g. for replays and forensics.
+ * Sees the records committed when each segment is mapped.
+ */
+class JournalReader
+{
+ public:
+  JournalReader(std::filesystem::path directory, std::string name)
+      : _dir(std::move(directory)), _name(std::move(name))
+  {
+  }
+
+  // Calls f(header, payload) for every committed record in order; returns the record count
+  template <typename F>
+  uint64_t forEach(F&& f) const
+  {
+    uint64_t count = 0;
+    for (const uint32_t index : detail::journalSegments(_dir, _name))
+    {
+      count += readSegment(detail::journalSegmentPath(_dir, _name, index), f);
+    }
+    return count;
+  }
+
+ private:
+  template <typename F>
+  static uint64_t readSegment(const std::filesystem::path& path, F& f)
+  {
+#if defined(__linux__)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::system_error(errno, std::generic_category(), "open " + path.string());
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(JournalSegmentHeader))
+    {
+      ::close(fd);
+      return 0;
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+      throw std::system_error(errno, std::generic_category(), "mmap " + path.string());
+    }
+
+    const auto* data = static_cast<const std::byte*>(p);
+    JournalSegmentHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, JournalSegmentHeader::Magic, sizeof(header.magic)) != 0)
+    {
+      munmap(p, size);
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument), "not a journal: " + path.string());
+    }
+
+    const size_t end = std::min<size_t>(
+        std::atomic_ref<uint64_t>(const_cast<JournalSegmentHeader*>(
+                                      reinterpret_cast<const JournalSegmentHeader*>(data))
+                                      ->end)
+            .load(std::memory_order_acquire),
+        size);
+    uint64_t count = 0;
+    size_t pos = header.headerBytes;
+    while (pos + sizeof(JournalRecordHeader) <= end)
+    {
+      JournalRecordHeader rec;
+      std::memcpy(&rec, data + pos, sizeof(rec));
+      pos += sizeof(rec);
+      if (pos + rec.size > end)
+      {
+        break;
+      }
+      f(rec, std::span<const std::byte>(data + pos, rec.size));
+      pos += (size_t(rec.size) + 7) & ~size_t{7};
+      ++count;
+    }
+    munmap(p, size);
+    return count;
+#else
+    (void)path;
+    (void)f;
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "journal");
+#endif
+  }
+
+  std::filesystem::path _dir;
+  std::string _name;
+};
+
+}  // namespace flox
@@ -0,0 +1,197 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/engine/abstract_subsystem.h"
+#include "flox/util/eventing/event_bus.h"
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+
+namespace flox
+{
+
+/**
+ * Set of EventBus shards with each symbol routed to exactly one shard.
+ *
+ * Consumers subscribed with a SymbolFilter attach only to the shards owning their
+ * symbols, so they never wake up for, or touch the ring slots of, unrelated symbols.
+ *
+ * A consumer attached to several shards is called from one thread per shard, and those
+ * calls run concurrently. Its callbacks must be thread-safe; only the events of one
+ * shard are delivered in order and one at a time. A listener that is not thread-safe
+ * has to be subscribed with a filter whose symbols share a shard.
+ */
+template <typename Event,
+          size_t Shards,
+          size_t CapacityPow2 = config::DEFAULT_EVENTBUS_CAPACITY,
+          size_t MaxConsumers = config::DEFAULT_EVENTBUS_MAX_CONSUMERS,
+          typename ProducerPolicy = MultiProducer>
+class PartitionedEventBus : public ISubsystem
+{
+  static_assert(Shards > 0, "PartitionedEventBus needs at least one shard");
+
+ public:
+  using Shard = EventBus<Event, CapacityPow2, MaxConsumers, ProducerPolicy>;
+  using Listener = typename Shard::Listener;
+  using ConsumerOptions = typename Shard::ConsumerOptions;
+
+  static_assert(Shard::HasSymbol, "Event type carries no symbol to partition on");
+
+  PartitionedEventBus() : PartitionedEventBus(EventBusConfig{}) {}
+
+  // Every shard gets its own ring sized and placed by `config`
+  explicit PartitionedEventBus(const EventBusConfig& config)
+  {
+    for (auto& shard : _shards)
+    {
+      shard = std::make_unique<Shard>(config);
+    }
+  }
+
+  static constexpr size_t shardOf(SymbolId symbol) { return symbol % Shards; }
+
+  void subscribe(Listener* listener, bool required = true)
+  {
+    subscribe(listener, ConsumerOptions{.required = required});
+  }
+
+  void subscribe(Listener* listener, SymbolFilter symbols)
+  {
+    subscribe(listener, ConsumerOptions{.symbols = std::move(symbols)});
+  }
+
+  // Attaches to every shard owning a symbol of options.symbols, or to all shards.
+  // A group member starts its own thread on shards where the group has none.
+  // Throws std::invalid_argument for an empty filter, which would attach nowhere.
+  void subscribe(Listener* listener, const ConsumerOptions& options)
+  {
+    std::array<bool, Shards> attach{};
+    if (options.symbols)
+    {
+      if (options.symbols->empty())
+      {
+        throw std::invalid_argument("PartitionedEventBus: empty symbol filter");
+      }
+      options.symbols->forEach([&](SymbolId s)
+                               { attach[shardOf(s)] = true; });
+    }
+    else
+    {
+      attach.fill(true);
+    }
+
+    for (size_t i = 0; i < Shards; ++i)
+    {
+      if (!attach[i])
+      {
+        continue;
+      }
+      if (options.group && !_shards[i]->isSubscribed(options.group))
+      {
+        auto own = options;
+        own.group = nullptr;
+        _shards[i]->subscribe(listener, own);
+      }
+      else
+      {
+        _shards[i]->subscribe(listener, options);
+      }
+    }
+  }
+
+  // Detaches from every shard; returns false if the listener was on none
+  bool unsubscribe(Listener* listener)
+  {
+    bool found = false;
+    for (auto& shard : _shards)
+    {
+      found |= shard->unsubscribe(listener);
+    }
+    return found;
+  }
+
+  void setWaitStrategy(const WaitStrategy& strategy)
+  {
+    for (auto& shard : _shards)
+    {
+      shard->setWaitStrategy(strategy);
+    }
+  }
+
+  void setOverflowPolicy(BusOverflowPolicy policy,
+                         std::chrono::nanoseconds evictAfter = std::chrono::milliseconds{1})
+  {
+    for (auto& shard : _shards)
+    {
+      shard->setOverflowPolicy(policy, evictAfter);
+    }
+  }
+
+  void enableDrainOnStop()
+  {
+    for (auto& shard : _shards)
+    {
+      shard->enableDrainOnStop();
+    }
+  }
+
+  void start() override
+  {
+    for (auto& shard : _shards)
+    {
+      shard->start();
+    }
+  }
+
+  void stop() override
+  {
+    for (auto& shard : _shards)
+    {
+      shard->stop();
+    }
+  }
+
+  // Returns the sequence within the event's shard
+  int64_t publish(const Event& ev) { return shardFor(ev).publish(ev); }
+  int64_t publish(Event&& ev)
+  {
+    Shard& shard = shardFor(ev);
+    return shard.publish(std::move(ev));
+  }
+
+  // Fails with -1 when the event's shard is full
+  int64_t tryPublish(const Event& ev) { return shardFor(ev).tryPublish(ev); }
+  int64_t tryPublish(Event&& ev)
+  {
+    Shard& shard = shardFor(ev);
+    return shard.tryPublish(std::move(ev));
+  }
+
+  void flush()
+  {
+    for (auto& shard : _shards)
+    {
+      shard->flush();
+    }
+  }
+
+  Shard& shard(size_t i) { return *_shards[i]; }
+  static constexpr size_t shardCount() { return Shards; }
+
+ private:
+  Shard& shardFor(const Event& ev) { return *_shards[shardOf(EventDispatcher<Event>::symbolOf(ev))]; }
+
+  std::array<std::unique_ptr<Shard>, Shards> _shards;
+};
+
+}  // namespace flox
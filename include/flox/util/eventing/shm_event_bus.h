@@ -0,0 +1,393 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/engine/abstract_subsystem.h"
+#include "flox/engine/event_dispatcher.h"
+#include "flox/util/concurrency/wait_strategy.h"
+#include "flox/util/eventing/event_bus.h"
+#include "flox/util/memory/shared_memory_region.h"
+#include "flox/util/performance/profile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace flox
+{
+
+/**
+ * EventBus variant whose ring, claim cursor and gating sequences live in a named
+ * shared memory region, so producers and consumers can be separate processes.
+ *
+ * Any number of processes may publish; each sequence is claimed with fetch_add on the
+ * shared cursor, exactly like a multi-producer EventBus. Consumers are attached per
+ * process with subscribe() and run on a thread of that process. Events are copied into
+ * the ring, so they must be trivially copyable.
+ */
+template <typename Event, size_t MaxConsumers = 16>
+class SharedMemoryEventBus : public ISubsystem
+{
+  static_assert(std::is_trivially_copyable_v<Event>, "Shared memory events must be trivially copyable");
+  static_assert(std::atomic<int64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                "Shared memory atomics must be lock-free to work across processes");
+
+ public:
+  using Listener = typename ListenerType<Event>::type;
+
+  // Create the region `name` (e.g. "/flox_trades") with a ring of `capacity` events, a
+  // power of two. Throws if the name is taken unless `existing` is ShmExisting::Replace.
+  SharedMemoryEventBus(const std::string& name, size_t capacity, ShmExisting existing = ShmExisting::Fail)
+      : _region(name, bytesFor(checkedCapacity(capacity)), existing)
+  {
+    auto* header = ::new (_region.data()) Header{};
+    header->capacity = capacity;
+    header->eventSize = sizeof(Event);
+    header->maxConsumers = MaxConsumers;
+    bind();
+    for (size_t i = 0; i < MaxConsumers; ++i)
+    {
+      ::new (&_cells[i]) Cell{};
+    }
+    for (size_t i = 0; i < _capacity; ++i)
+    {
+      ::new (&_published[i]) std::atomic<int64_t>(-1);
+    }
+    header->magic.store(Magic, std::memory_order_release);
+  }
+
+  // Attach to a region created by another process with the same Event and MaxConsumers
+  explicit SharedMemoryEventBus(const std::string& name) : _region(name)
+  {
+    const auto* header = static_cast<const Header*>(_region.data());
+    if (_region.size() < sizeof(Header) || header->magic.load(std::memory_order_acquire) != Magic)
+    {
+      throw std::runtime_error("SharedMemoryEventBus: " + name + " is not initialized");
+    }
+    if (header->eventSize != sizeof(Event) || header->maxConsumers != MaxConsumers ||
+        _region.size() < bytesFor(header->capacity))
+    {
+      throw std::runtime_error("SharedMemoryEventBus: " + name + " has a different layout");
+    }
+    bind();
+  }
+
+  ~SharedMemoryEventBus()
+  {
+    stop();
+    for (const auto& c : _local)
+    {
+      _cells[c.cell].gating.store(INT64_MAX, std::memory_order_seq_cst);
+      _cells[c.cell].state.store(0, std::memory_order_release);
+    }
+  }
+
+  SharedMemoryEventBus(const SharedMemoryEventBus&) = delete;
+  SharedMemoryEventBus& operator=(const SharedMemoryEventBus&) = delete;
+
+  /**
+   * @brief Attach a consumer of this process; call before start()
+   *
+   * The consumer takes a gating cell in the shared region and starts at the current
+   * cursor. It gates publishers in every process until this bus object is destroyed.
+   */
+  void subscribe(Listener* listener)
+  {
+    assert(listener && "Listener must not be null");
+    assert(!_running.load(std::memory_order_acquire) && "subscribe before start()");
+
+    uint32_t cell = 0;
+    for (; cell < MaxConsumers; ++cell)
+    {
+      uint32_t expected = 0;
+      if (_cells[cell].state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
+      {
+        break;
+      }
+    }
+    if (cell == MaxConsumers)
+    {
+      throw std::runtime_error("SharedMemoryEventBus: all consumer cells are taken");
+    }
+
+    // Claims already in flight were checked against older gating values, which never
+    // exceed the cursor
+    _cells[cell].gating.store(_header->next.load(std::memory_order_acquire), std::memory_order_seq_cst);
+    _local.push_back(LocalConsumer{listener, cell, std::nullopt});
+  }
+
+  // Idle behavior of this process's consumers and publishers. Parking strategies sleep
+  // for parkTimeout, since no futex is shared between processes.
+  void setWaitStrategy(const WaitStrategy& strategy) { _waitStrategy = strategy; }
+
+  void start() override
+  {
+    if (_running.exchange(true, std::memory_order_acq_rel))
+    {
+      return;
+    }
+    for (auto& c : _local)
+    {
+      launch(c);
+    }
+  }
+
+  // Consumers keep their cells and gating sequences; a later start() resumes after them
+  void stop() override
+  {
+    if (!_running.exchange(false, std::memory_order_acq_rel))
+    {
+      return;
+    }
+    for (auto& c : _local)
+    {
+      c.thread.reset();
+    }
+  }
+
+  int64_t publish(const Event& ev)
+  {
+    FLOX_PROFILE_SCOPE("ShmBus::publish");
+
+    const int64_t seq = _header->next.fetch_add(1, std::memory_order_acq_rel) + 1;
+    waitForCapacity(seq);
+    store(seq, ev);
+    return seq;
+  }
+
+  // One claim per ring-sized chunk; returns the last sequence, or -1 if `events` is empty
+  int64_t publishBatch(std::span<const Event> events)
+  {
+    FLOX_PROFILE_SCOPE("ShmBus::publishBatch");
+
+    int64_t last = -1;
+    while (!events.empty())
+    {
+      const size_t n = std::min(events.size(), _capacity);
+      last = _header->next.fetch_add(static_cast<int64_t>(n), std::memory_order_acq_rel) + static_cast<int64_t>(n);
+      waitForCapacity(last);
+      const int64_t first = last - static_cast<int64_t>(n) + 1;
+      for (size_t i = 0; i < n; ++i)
+      {
+        store(first + static_cast<int64_t>(i), events[i]);
+      }
+      events = events.subspan(n);
+    }
+    return last;
+  }
+
+  // Block until every attached consumer, in any process, has handled `seq`
+  void waitConsumed(int64_t seq)
+  {
+    Waiter waiter(_waitStrategy);
+    while (minGating() < seq)
+    {
+      waiter.pause();
+    }
+  }
+
+  void flush() { waitConsumed(_header->next.load(std::memory_order_acquire)); }
+
+  // Consumers attached by all processes
+  uint32_t consumerCount() const
+  {
+    uint32_t n = 0;
+    for (size_t i = 0; i < MaxConsumers; ++i)
+    {
+      n += _cells[i].state.load(std::memory_order_acquire) != 0;
+    }
+    return n;
+  }
+
+  size_t capacity() const { return _capacity; }
+  const std::string& name() const { return _region.name(); }
+  bool owner() const { return _region.owner(); }
+
+ private:
+  static constexpr uint64_t Magic = 0x464c4f5853484d31ull;  // "FLOXSHM1"
+
+  struct alignas(64) Header
+  {
+    std::atomic<uint64_t> magic{0};  // set last by the creator
+    uint64_t capacity{0};
+    uint32_t eventSize{0};
+    uint32_t maxConsumers{0};
+    alignas(64) std::atomic<int64_t> next{-1};  // last claimed sequence
+  };
+
+  struct alignas(64) Cell
+  {
+    std::atomic<int64_t> gating{INT64_MAX};  // last handled sequence; INT64_MAX when free
+    std::atomic<uint32_t> state{0};          // 1 while a consumer owns the cell
+  };
+
+  struct LocalConsumer
+  {
+    Listener* listener;
+    uint32_t cell;
+    std::optional<std::jthread> thread;
+  };
+
+  static constexpr size_t align64(size_t n) { return (n + 63) & ~size_t{63}; }
+  static constexpr size_t publishedOffset() { return sizeof(Header) + MaxConsumers * sizeof(Cell); }
+  static constexpr size_t slotsOffset(size_t capacity)
+  {
+    return publishedOffset() + align64(capacity * sizeof(std::atomic<int64_t>));
+  }
+  static size_t checkedCapacity(size_t capacity)
+  {
+    if (!std::has_single_bit(capacity))
+    {
+      throw std::invalid_argument("SharedMemoryEventBus: capacity " + std::to_string(capacity) +
+                                  " is not a power of two");
+    }
+    return capacity;
+  }
+
+  static constexpr size_t bytesFor(size_t capacity) { return slotsOffset(capacity) + capacity * sizeof(Event); }
+
+  void bind()
+  {
+    auto* base = static_cast<std::byte*>(_region.data());
+    _header = reinterpret_cast<Header*>(base);
+    _capacity = _header->capacity;
+    _mask = _capacity - 1;
+    _cells = reinterpret_cast<Cell*>(base + sizeof(Header));
+    _published = reinterpret_cast<std::atomic<int64_t>*>(base + publishedOffset());
+    _slots = reinterpret_cast<Event*>(base + slotsOffset(_capacity));
+  }
+
+  void store(int64_t seq, const Event& ev)
+  {
+    const size_t idx = size_t(seq) & _mask;
+    Event* slot = ::new (&_slots[idx]) Event(ev);
+    if constexpr (requires { slot->tickSequence; })
+    {
+      slot->tickSequence = static_cast<uint64_t>(seq);
+    }
+    _published[idx].store(seq, std::memory_order_release);
+  }
+
+  int64_t minGating() const
+  {
+    int64_t mn = INT64_MAX;
+    for (size_t i = 0; i < MaxConsumers; ++i)
+    {
+      const int64_t s = _cells[i].gating.load(std::memory_order_acquire);
+      mn = s < mn ? s : mn;
+    }
+    return mn == INT64_MAX ? _header->next.load(std::memory_order_acquire) : mn;
+  }
+
+  void waitForCapacity(int64_t last)
+  {
+    const int64_t wrap = last - static_cast<int64_t>(_capacity);
+    if (wrap <= _cachedMin.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+
+    Waiter waiter(_waitStrategy);
+    for (;;)
+    {
+      const int64_t mn = minGating();
+      _cachedMin.store(mn, std::memory_order_relaxed);
+      if (wrap <= mn)
+      {
+        break;
+      }
+      waiter.pause();
+    }
+  }
+
+  void launch(LocalConsumer& c)
+  {
+    c.thread.emplace([this, l = c.listener, &cell = _cells[c.cell], strategy = _waitStrategy]
+                     {
+      Waiter waiter(strategy);
+      int64_t next = cell.gating.load(std::memory_order_relaxed);
+
+      while (_running.load(std::memory_order_acquire))
+      {
+        const int64_t seq = next + 1;
+        if (_published[size_t(seq) & _mask].load(std::memory_order_acquire) != seq)
+        {
+          waiter.pause();
+          continue;
+        }
+
+        int64_t last = seq;
+        const int64_t limit = seq + static_cast<int64_t>(_capacity) - 1;
+        while (last < limit && _published[size_t(last + 1) & _mask].load(std::memory_order_acquire) == last + 1)
+        {
+          ++last;
+        }
+
+        {
+          FLOX_PROFILE_SCOPE("ShmBus::deliver");
+          deliver(*l, seq, last);
+        }
+        cell.gating.store(last, std::memory_order_release);
+        next = last;
+        waiter.reset();
+      } });
+  }
+
+  // Dispatch [from, to] as at most two contiguous spans, split where the ring wraps
+  void deliver(Listener& listener, int64_t from, int64_t to)
+  {
+    while (from <= to)
+    {
+      const size_t idx = size_t(from) & _mask;
+      const size_t n = std::min(static_cast<size_t>(to - from + 1), _capacity - idx);
+      const std::span<const Event> batch(&_slots[idx], n);
+
+      if constexpr (requires { EventDispatcher<Event>::dispatchBatch(batch, listener); })
+      {
+        if (n > 1)
+        {
+          EventDispatcher<Event>::dispatchBatch(batch, listener);
+          from += static_cast<int64_t>(n);
+          continue;
+        }
+      }
+      for (const auto& ev : batch)
+      {
+        EventDispatcher<Event>::dispatch(ev, listener);
+      }
+      from += static_cast<int64_t>(n);
+    }
+  }
+
+  SharedMemoryRegion _region;
+  Header* _header{nullptr};
+  Cell* _cells{nullptr};
+  std::atomic<int64_t>* _published{nullptr};
+  Event* _slots{nullptr};
+  size_t _capacity{0};
+  size_t _mask{0};
+
+  std::atomic<int64_t> _cachedMin{-1};  // per process, refreshed by this process's publishers
+  std::atomic<bool> _running{false};
+  std::vector<LocalConsumer> _local;
+  WaitStrategy _waitStrategy{};
+};
+
+}  // namespace flox
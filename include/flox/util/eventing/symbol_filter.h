@@ -0,0 +1,90 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/common.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace flox
+{
+
+// Set of symbols a consumer wants to see, stored as a bitmap indexed by SymbolId
+class SymbolFilter
+{
+ public:
+  SymbolFilter() = default;
+
+  SymbolFilter(std::initializer_list<SymbolId> symbols)
+  {
+    for (SymbolId s : symbols)
+    {
+      add(s);
+    }
+  }
+
+  void add(SymbolId symbol)
+  {
+    const size_t word = symbol >> 6;
+    if (word >= _words.size())
+    {
+      _words.resize(word + 1, 0);
+    }
+    _words[word] |= uint64_t{1} << (symbol & 63);
+  }
+
+  void remove(SymbolId symbol)
+  {
+    const size_t word = symbol >> 6;
+    if (word < _words.size())
+    {
+      _words[word] &= ~(uint64_t{1} << (symbol & 63));
+    }
+  }
+
+  bool contains(SymbolId symbol) const noexcept
+  {
+    const size_t word = symbol >> 6;
+    return word < _words.size() && ((_words[word] >> (symbol & 63)) & 1) != 0;
+  }
+
+  bool empty() const noexcept
+  {
+    for (uint64_t w : _words)
+    {
+      if (w != 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename Fn>
+  void forEach(Fn&& fn) const
+  {
+    for (size_t i = 0; i < _words.size(); ++i)
+    {
+      for (uint64_t w = _words[i]; w != 0; w &= w - 1)
+      {
+        fn(static_cast<SymbolId>(i * 64 + static_cast<size_t>(std::countr_zero(w))));
+      }
+    }
+  }
+
+ private:
+  std::vector<uint64_t> _words;
+};
+
+}  // namespace flox
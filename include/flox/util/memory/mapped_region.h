@@ -0,0 +1,158 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace flox
+{
+
+struct MemoryPlacement
+{
+  bool hugePages{false};  // MAP_HUGETLB, falling back to transparent huge pages
+  int numaNode{-1};       // preferred NUMA node, -1 for the kernel's default policy
+  bool prefault{true};    // touch every page up front instead of on the hot path
+};
+
+/**
+ * Anonymous memory mapping for large hot structures such as ring buffers.
+ *
+ * Placement requests are best effort: without reserved huge pages or NUMA support the
+ * region is still allocated, just with normal pages or the default policy. Memory is
+ * zero-initialized.
+ */
+class MappedRegion
+{
+ public:
+  static constexpr size_t HugePageSize = 2u << 20;
+
+  MappedRegion() = default;
+
+  MappedRegion(size_t bytes, const MemoryPlacement& placement)
+  {
+#if defined(__linux__)
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t granule = placement.hugePages ? HugePageSize : pageSize;
+    _size = (bytes + granule - 1) / granule * granule;
+
+    void* p = MAP_FAILED;
+    if (placement.hugePages)
+    {
+      p = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      _hugePages = p != MAP_FAILED;
+    }
+    if (p == MAP_FAILED)
+    {
+      p = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED)
+      {
+        throw std::bad_alloc();
+      }
+#ifdef MADV_HUGEPAGE
+      if (placement.hugePages)
+      {
+        madvise(p, _size, MADV_HUGEPAGE);
+      }
+#endif
+    }
+    _data = p;
+
+#ifdef SYS_mbind
+    if (placement.numaNode >= 0 && placement.numaNode < 64)
+    {
+      constexpr int MpolPreferred = 1;
+      const unsigned long nodeMask = 1ul << placement.numaNode;
+      _numaBound = syscall(SYS_mbind, _data, _size, MpolPreferred, &nodeMask, sizeof(nodeMask) * 8, 0) == 0;
+    }
+#endif
+
+    // Pages are allocated on first touch, so this also applies the NUMA policy
+    if (placement.prefault)
+    {
+      const size_t step = _hugePages ? HugePageSize : pageSize;
+      auto* bytesPtr = static_cast<volatile uint8_t*>(_data);
+      for (size_t off = 0; off < _size; off += step)
+      {
+        bytesPtr[off] = 0;
+      }
+    }
+#else
+    (void)placement;
+    _size = (bytes + 63) / 64 * 64;
+    _data = ::operator new(_size, std::align_val_t{64});
+    std::memset(_data, 0, _size);
+#endif
+  }
+
+  ~MappedRegion() { release(); }
+
+  MappedRegion(const MappedRegion&) = delete;
+  MappedRegion& operator=(const MappedRegion&) = delete;
+
+  MappedRegion(MappedRegion&& other) noexcept
+      : _data(std::exchange(other._data, nullptr)),
+        _size(std::exchange(other._size, 0)),
+        _hugePages(other._hugePages),
+        _numaBound(other._numaBound)
+  {
+  }
+
+  MappedRegion& operator=(MappedRegion&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      _data = std::exchange(other._data, nullptr);
+      _size = std::exchange(other._size, 0);
+      _hugePages = other._hugePages;
+      _numaBound = other._numaBound;
+    }
+    return *this;
+  }
+
+  void* data() const noexcept { return _data; }
+  size_t size() const noexcept { return _size; }
+
+  // Whether the region is backed by explicitly reserved huge pages / bound to the node
+  bool hugePages() const noexcept { return _hugePages; }
+  bool numaBound() const noexcept { return _numaBound; }
+
+ private:
+  void release() noexcept
+  {
+    if (!_data)
+    {
+      return;
+    }
+#if defined(__linux__)
+    munmap(_data, _size);
+#else
+    ::operator delete(_data, std::align_val_t{64});
+#endif
+    _data = nullptr;
+  }
+
+  void* _data{nullptr};
+  size_t _size{0};
+  bool _hugePages{false};
+  bool _numaBound{false};
+};
+
+}  // namespace flox
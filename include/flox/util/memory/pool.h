@@ -36,6 +36,7 @@ template <typename Derived>
 struct PoolableBase : public RefCountable
 {
   void* _origin = nullptr;
+  void (*_releaseFn)(void*, void*) = nullptr;  // set by the owning pool
 
   void setPool(void* pool) { _origin = pool; }
 
@@ -45,8 +46,6 @@ struct PoolableBase : public RefCountable
     _releaseFn(_origin, static_cast<Derived*>(this));
   }
 
-  static inline void (*_releaseFn)(void*, void*) = nullptr;
-
   void clear() {}
 };
 
@@ -146,7 +145,8 @@ class Pool
 
       obj->setPool(this);
 
-      T::_releaseFn = [](void* pool, void* ptr)
+      // Per object: pools of the same T with different capacities can coexist
+      obj->_releaseFn = [](void* pool, void* ptr)
       {
         static_cast<Pool<T, Capacity>*>(pool)->release(static_cast<T*>(ptr));
       };
@@ -155,11 +155,6 @@ class Pool
     }
   }
 
-  ~Pool()
-  {
-    T::_releaseFn = nullptr;
-  }
-
   std::optional<Handle<T>> acquire()
   {
     T* obj = nullptr;
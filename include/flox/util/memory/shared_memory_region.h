@@ -0,0 +1,172 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace flox
+{
+
+// What creating a region does when an object of that name already exists
+enum class ShmExisting
+{
+  Fail,     // throw std::system_error with EEXIST
+  Replace,  // unlink it first; processes still attached keep the old memory
+};
+
+/**
+ * Named POSIX shared memory mapping (`/dev/shm/<name>` on Linux).
+ *
+ * The creating side owns the name and unlinks it on destruction; processes that attach
+ * only unmap. Memory of a newly created region is zero-initialized. Failures throw
+ * std::system_error.
+ */
+class SharedMemoryRegion
+{
+ public:
+  SharedMemoryRegion() = default;
+
+  // Create `name` with `bytes` bytes. A region left behind by a dead owner is only
+  // replaced with ShmExisting::Replace, since a live one cannot be told apart from it.
+  SharedMemoryRegion(std::string name, size_t bytes, ShmExisting existing = ShmExisting::Fail)
+      : _name(std::move(name)), _owner(true)
+  {
+#if defined(__linux__)
+    if (existing == ShmExisting::Replace)
+    {
+      shm_unlink(_name.c_str());
+    }
+    const int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+      throw std::system_error(errno, std::generic_category(), "shm_open " + _name);
+    }
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+      const int err = errno;
+      close(fd);
+      shm_unlink(_name.c_str());
+      throw std::system_error(err, std::generic_category(), "ftruncate " + _name);
+    }
+    map(fd, bytes);
+#else
+    (void)bytes;
+    (void)existing;
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "shared memory");
+#endif
+  }
+
+  // Attach to a region another process created; its size is taken from the object
+  explicit SharedMemoryRegion(std::string name) : _name(std::move(name)), _owner(false)
+  {
+#if defined(__linux__)
+    const int fd = shm_open(_name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+      throw std::system_error(errno, std::generic_category(), "shm_open " + _name);
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0)
+    {
+      const int err = errno;
+      close(fd);
+      throw std::system_error(err, std::generic_category(), "fstat " + _name);
+    }
+    map(fd, static_cast<size_t>(st.st_size));
+#else
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "shared memory");
+#endif
+  }
+
+  ~SharedMemoryRegion() { release(); }
+
+  SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+  SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+  SharedMemoryRegion(SharedMemoryRegion&& other) noexcept
+      : _name(std::move(other._name)),
+        _data(std::exchange(other._data, nullptr)),
+        _size(std::exchange(other._size, 0)),
+        _owner(std::exchange(other._owner, false))
+  {
+  }
+
+  SharedMemoryRegion& operator=(SharedMemoryRegion&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      _name = std::move(other._name);
+      _data = std::exchange(other._data, nullptr);
+      _size = std::exchange(other._size, 0);
+      _owner = std::exchange(other._owner, false);
+    }
+    return *this;
+  }
+
+  void* data() const noexcept { return _data; }
+  size_t size() const noexcept { return _size; }
+  const std::string& name() const noexcept { return _name; }
+  bool owner() const noexcept { return _owner; }
+
+ private:
+#if defined(__linux__)
+  void map(int fd, size_t bytes)
+  {
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int err = errno;
+    close(fd);
+    if (p == MAP_FAILED)
+    {
+      if (_owner)
+      {
+        shm_unlink(_name.c_str());
+      }
+      throw std::system_error(err, std::generic_category(), "mmap " + _name);
+    }
+    _data = p;
+    _size = bytes;
+  }
+#endif
+
+  void release() noexcept
+  {
+    if (!_data)
+    {
+      return;
+    }
+#if defined(__linux__)
+    munmap(_data, _size);
+    if (_owner)
+    {
+      shm_unlink(_name.c_str());
+    }
+#endif
+    _data = nullptr;
+  }
+
+  std::string _name;
+  void* _data{nullptr};
+  size_t _size{0};
+  bool _owner{false};
+};
+
+}  // namespace flox
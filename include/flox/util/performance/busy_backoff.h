@@ -7,6 +7,8 @@
  * license information.
  */
 
+#pragma once
+
 #include <thread>
 #if defined(__x86_64__) || defined(__aarch64__)
 #include <immintrin.h>
@@ -15,6 +17,13 @@
 namespace flox
 {
 
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__aarch64__)
+  _mm_pause();
+#endif
+}
+
 struct BusyBackoff
 {
   int spins = 0;
@@ -23,9 +32,7 @@ struct BusyBackoff
   {
     if (spins < 2048)
     {
-#if defined(__x86_64__) || defined(__aarch64__)
-      _mm_pause();
-#endif
+      cpuRelax();
       ++spins;
       return;
     }
@@ -0,0 +1,59 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#pragma once
+
+#include "flox/book/events/book_update_event.h"
+#include "flox/util/memory/pool.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace flox::test
+{
+
+using BookUpdatePool = pool::Pool<BookUpdateEvent, 63>;
+
+inline BookLevel level(double px, double qty) { return {Price::fromDouble(px), Quantity::fromDouble(qty)}; }
+
+// Pooled book update. A bus consumer may still hold every event, so an empty pool is
+// given a second to get one back; after that the test fails and stops here.
+inline pool::Handle<BookUpdateEvent> make(BookUpdatePool& pool, SymbolId symbol, BookUpdateType type,
+                                          int64_t seq, const std::vector<BookLevel>& bids = {},
+                                          const std::vector<BookLevel>& asks = {}, int64_t prevSeq = 0)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  auto opt = pool.acquire();
+  while (!opt && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::yield();
+    opt = pool.acquire();
+  }
+  if (!opt)
+  {
+    ADD_FAILURE() << "book update pool exhausted";
+    throw std::runtime_error("book update pool exhausted");
+  }
+
+  auto& u = *opt;
+  u->update.symbol = symbol;
+  u->update.type = type;
+  u->seq = seq;
+  u->prevSeq = prevSeq;
+  u->update.bids.assign(bids.begin(), bids.end());
+  u->update.asks.assign(asks.begin(), asks.end());
+  return std::move(u);
+}
+
+}  // namespace flox::test
@@ -0,0 +1,141 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/book_publisher.h"
+#include "flox/book/bus/book_update_bus.h"
+#include "flox/book/events/book_update_event.h"
+
+#include "book_update_helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace flox;
+using namespace flox::test;
+
+TEST(BookPublisherTest, PublishesTopOfBookAndDepth)
+{
+  BookUpdatePool pool;
+  BookPublisher<3> pub{1, 7, Price::fromDouble(0.1)};
+
+  EXPECT_FALSE(pub.topOfBook().hasBid());
+  EXPECT_EQ(pub.version(), 0u);
+
+  auto snap = make(pool, 7, BookUpdateType::SNAPSHOT, 10,
+                   {level(100.0, 1), level(99.9, 2), level(99.5, 3), level(99.0, 4)},
+                   {level(100.2, 5)});
+  pub.onBookUpdate(*snap);
+
+  const TopOfBook top = pub.topOfBook();
+  EXPECT_EQ(top.symbol, 7u);
+  EXPECT_EQ(top.seq, 10);
+  EXPECT_EQ(top.bid, Price::fromDouble(100.0));
+  EXPECT_EQ(top.bidQty, Quantity::fromDouble(1));
+  EXPECT_EQ(top.ask, Price::fromDouble(100.2));
+
+  const auto depth = pub.depth();
+  ASSERT_EQ(depth.bidLevels().size(), 3u);
+  ASSERT_EQ(depth.askLevels().size(), 1u);
+  EXPECT_EQ(depth.bids[2].price, Price::fromDouble(99.5));
+  EXPECT_EQ(depth.asks[0].quantity, Quantity::fromDouble(5));
+  EXPECT_EQ(pub.version(), 1u);
+
+  // Other symbols on the same bus are ignored
+  auto other = make(pool, 8, BookUpdateType::SNAPSHOT, 11, {level(1.0, 1)}, {});
+  pub.onBookUpdate(*other);
+  EXPECT_EQ(pub.version(), 1u);
+
+  auto sweep = make(pool, 7, BookUpdateType::DELTA, 12, {}, {level(100.2, 0)});
+  pub.onBookUpdate(*sweep);
+  EXPECT_FALSE(pub.topOfBook().hasAsk());
+  EXPECT_EQ(pub.depth().askCount, 0u);
+}
+
+TEST(BookPublisherTest, BatchIsPublishedOnce)
+{
+  BookUpdatePool pool;
+  BookPublisher<2> pub{1, 7, Price::fromDouble(0.1)};
+
+  std::vector<pool::Handle<BookUpdateEvent>> batch;
+  batch.push_back(make(pool, 7, BookUpdateType::SNAPSHOT, 1, {level(10.0, 1)}, {level(10.1, 1)}));
+  batch.push_back(make(pool, 7, BookUpdateType::DELTA, 2, {level(10.0, 3)}, {}));
+  batch.push_back(make(pool, 9, BookUpdateType::DELTA, 3, {level(50.0, 3)}, {}));
+
+  EXPECT_TRUE(pub.onBookUpdateBatch(batch));
+  EXPECT_EQ(pub.version(), 1u);
+  EXPECT_EQ(pub.topOfBook().seq, 2);
+  EXPECT_EQ(pub.topOfBook().bidQty, Quantity::fromDouble(3));
+}
+
+TEST(BookPublisherTest, ReadersOnOtherThreadsSeeConsistentSnapshots)
+{
+  BookUpdateBus bus;
+  BookUpdatePool pool;
+  auto pub = std::make_unique<BookPublisher<4>>(1, 7, Price::fromDouble(0.1));
+  bus.subscribe(pub.get());
+  bus.start();
+
+  // Every update n moves the whole book to quantities n, so one snapshot must carry a
+  // single quantity on both sides and on every level, equal to its seq
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> bad{0}, reads{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 2; ++r)
+  {
+    readers.emplace_back(
+        [&]
+        {
+          while (!done.load(std::memory_order_acquire))
+          {
+            const auto d = pub->depth();
+            const auto expect = Quantity::fromRaw(d.seq);
+            for (const auto& l : d.bidLevels())
+            {
+              bad += l.quantity != expect;
+            }
+            for (const auto& l : d.askLevels())
+            {
+              bad += l.quantity != expect;
+            }
+            const TopOfBook t = pub->topOfBook();
+            bad += t.hasBid() && t.bidQty != Quantity::fromRaw(t.seq);
+            reads.fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+  }
+
+  for (int64_t n = 1; n <= 20'000; ++n)
+  {
+    std::vector<BookLevel> b, a;
+    for (int k = 0; k < 4; ++k)
+    {
+      b.push_back({Price::fromDouble(100.0 - 0.1 * k), Quantity::fromRaw(n)});
+      a.push_back({Price::fromDouble(100.1 + 0.1 * k), Quantity::fromRaw(n)});
+    }
+    bus.publish(make(pool, 7, n == 1 ? BookUpdateType::SNAPSHOT : BookUpdateType::DELTA, n, b, a));
+  }
+  bus.flush();
+  while (reads.load() < 1000)
+  {
+    std::this_thread::yield();
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& t : readers)
+  {
+    t.join();
+  }
+  bus.stop();
+
+  EXPECT_EQ(bad.load(), 0u);
+  EXPECT_EQ(pub->topOfBook().seq, 20'000);
+  EXPECT_EQ(pub->depth().askCount, 4u);
+}
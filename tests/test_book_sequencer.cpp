@@ -0,0 +1,275 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/book_sequencer.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/order_book_set.h"
+
+#include "book_update_helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace flox;
+using namespace flox::test;
+
+namespace
+{
+
+// Feeds events through a sequencer and records the (symbol, seq) of every applied one
+struct Harness
+{
+  std::vector<SymbolId> requests;
+  std::vector<std::pair<SymbolId, int64_t>> applied;
+  BookSequencer sequencer;
+  BookUpdatePool pool;
+
+  explicit Harness(BookSequencer::Options options = {})
+      : sequencer(8, [this](SymbolId s) { requests.push_back(s); }, options)
+  {
+  }
+
+  void feed(SymbolId symbol, BookUpdateType type, int64_t seq, int64_t prevSeq = 0)
+  {
+    auto h = make(pool, symbol, type, seq, {}, {}, prevSeq);
+    sequencer.process(*h, [this](const BookUpdateEvent& e)
+                      { applied.emplace_back(e.update.symbol, e.seq); });
+  }
+
+  std::vector<int64_t> appliedSeqs(SymbolId symbol) const
+  {
+    std::vector<int64_t> out;
+    for (const auto& [s, seq] : applied)
+    {
+      if (s == symbol)
+      {
+        out.push_back(seq);
+      }
+    }
+    return out;
+  }
+};
+
+constexpr auto SNAPSHOT = BookUpdateType::SNAPSHOT;
+constexpr auto DELTA = BookUpdateType::DELTA;
+
+constexpr MemoryPlacement NoHugePages{};
+
+}  // namespace
+
+TEST(BookSequencerTest, GapBuffersDeltasUntilSnapshotThenReplays)
+{
+  Harness h;
+  h.feed(1, SNAPSHOT, 10);
+  h.feed(1, DELTA, 11, 10);
+  h.feed(1, DELTA, 12);  // prevSeq left at 0: seq - 1 is the predecessor
+  EXPECT_FALSE(h.sequencer.isStale(1));
+
+  // 13 is lost
+  h.feed(1, DELTA, 14, 13);
+  EXPECT_TRUE(h.sequencer.isStale(1));
+  EXPECT_EQ(h.requests, std::vector<SymbolId>{1});
+  h.feed(1, DELTA, 15, 14);
+  h.feed(1, DELTA, 16, 15);
+  EXPECT_EQ(h.appliedSeqs(1), (std::vector<int64_t>{10, 11, 12}));
+
+  // The snapshot covers up to 14; 15 and 16 are replayed on top of it
+  h.feed(1, SNAPSHOT, 14);
+  EXPECT_FALSE(h.sequencer.isStale(1));
+  EXPECT_EQ(h.appliedSeqs(1), (std::vector<int64_t>{10, 11, 12, 14, 15, 16}));
+
+  h.feed(1, DELTA, 17, 16);
+  EXPECT_EQ(h.appliedSeqs(1).back(), 17);
+
+  const auto stats = h.sequencer.stats();
+  EXPECT_EQ(stats.gaps, 1u);
+  EXPECT_EQ(stats.recoveries, 1u);
+  EXPECT_EQ(stats.snapshotRequests, 1u);
+  EXPECT_EQ(stats.buffered, 3u);
+  EXPECT_EQ(stats.replayed, 2u);
+  EXPECT_EQ(stats.staleSymbols, 0u);
+  EXPECT_GE(stats.lastRecoveryNs, 0);
+  EXPECT_EQ(stats.maxRecoveryNs, stats.lastRecoveryNs);
+  EXPECT_EQ(stats.totalRecoveryNs, stats.lastRecoveryNs);
+}
+
+TEST(BookSequencerTest, GapOnOneSymbolDoesNotHoldOthers)
+{
+  Harness h;
+  h.feed(1, SNAPSHOT, 100);
+  h.feed(2, SNAPSHOT, 500);
+
+  h.feed(1, DELTA, 103, 102);
+  for (int64_t seq = 501; seq <= 510; ++seq)
+  {
+    h.feed(2, DELTA, seq, seq - 1);
+  }
+
+  EXPECT_TRUE(h.sequencer.isStale(1));
+  EXPECT_FALSE(h.sequencer.isStale(2));
+  EXPECT_EQ(h.appliedSeqs(2).size(), 11u);
+  EXPECT_EQ(h.appliedSeqs(2).back(), 510);
+  EXPECT_EQ(h.sequencer.stats().staleSymbols, 1u);
+
+  // Unsequenced updates always pass through
+  h.feed(1, DELTA, 0);
+  EXPECT_EQ(h.appliedSeqs(1), (std::vector<int64_t>{100, 0}));
+}
+
+TEST(BookSequencerTest, DuplicatesAreDiscarded)
+{
+  Harness h;
+  h.feed(3, SNAPSHOT, 20);
+  h.feed(3, DELTA, 21, 20);
+  h.feed(3, DELTA, 21, 20);
+  h.feed(3, DELTA, 19, 18);
+  h.feed(3, DELTA, 22, 21);
+
+  EXPECT_EQ(h.appliedSeqs(3), (std::vector<int64_t>{20, 21, 22}));
+  EXPECT_FALSE(h.sequencer.isStale(3));
+  EXPECT_EQ(h.sequencer.stats().discarded, 2u);
+  EXPECT_EQ(h.sequencer.stats().gaps, 0u);
+}
+
+TEST(BookSequencerTest, LateSnapshotDoesNotRewindSyncedSymbol)
+{
+  Harness h;
+  h.feed(5, SNAPSHOT, 10);
+  h.feed(5, DELTA, 11, 10);
+  h.feed(5, DELTA, 12, 11);
+
+  h.feed(5, SNAPSHOT, 11);  // delivered late
+  h.feed(5, SNAPSHOT, 12);  // repeated
+  h.feed(5, DELTA, 13, 12);
+
+  EXPECT_EQ(h.appliedSeqs(5), (std::vector<int64_t>{10, 11, 12, 13}));
+  EXPECT_FALSE(h.sequencer.isStale(5));
+  EXPECT_EQ(h.sequencer.stats().discarded, 2u);
+  EXPECT_EQ(h.sequencer.stats().gaps, 0u);
+
+  // A newer snapshot still replaces the book
+  h.feed(5, SNAPSHOT, 20);
+  h.feed(5, DELTA, 21, 20);
+  EXPECT_EQ(h.appliedSeqs(5).back(), 21);
+  EXPECT_FALSE(h.sequencer.isStale(5));
+}
+
+TEST(BookSequencerTest, DeltasBeforeFirstSnapshotWaitForOne)
+{
+  Harness h;
+  h.feed(4, DELTA, 7, 6);
+  EXPECT_TRUE(h.sequencer.isStale(4));
+  EXPECT_TRUE(h.applied.empty());
+  EXPECT_EQ(h.requests, std::vector<SymbolId>{4});
+
+  h.feed(4, DELTA, 8, 7);
+  h.feed(4, SNAPSHOT, 7);
+  EXPECT_EQ(h.appliedSeqs(4), (std::vector<int64_t>{7, 8}));
+  EXPECT_FALSE(h.sequencer.isStale(4));
+}
+
+TEST(BookSequencerTest, SnapshotOlderThanBufferIsRequestedAgain)
+{
+  Harness h;
+  h.feed(1, SNAPSHOT, 10);
+  h.feed(1, DELTA, 20, 19);
+  h.feed(1, DELTA, 21, 20);
+
+  // Deltas 11..19 are neither in the snapshot nor buffered
+  h.feed(1, SNAPSHOT, 12);
+  EXPECT_TRUE(h.sequencer.isStale(1));
+  EXPECT_EQ(h.requests, (std::vector<SymbolId>{1, 1}));
+  EXPECT_EQ(h.appliedSeqs(1), (std::vector<int64_t>{10, 12}));
+
+  h.feed(1, DELTA, 22, 21);
+  h.feed(1, SNAPSHOT, 21);
+  EXPECT_FALSE(h.sequencer.isStale(1));
+  EXPECT_EQ(h.appliedSeqs(1), (std::vector<int64_t>{10, 12, 21, 22}));
+
+  const auto stats = h.sequencer.stats();
+  EXPECT_EQ(stats.gaps, 2u);
+  EXPECT_EQ(stats.recoveries, 1u);
+}
+
+TEST(BookSequencerTest, BufferKeepsNewestDeltasAndRetriesRequest)
+{
+  Harness h{{.maxBuffered = 2, .retryNs = 0}};
+  h.feed(1, SNAPSHOT, 1);
+  h.feed(1, DELTA, 3, 2);
+  h.feed(1, DELTA, 4, 3);
+  h.feed(1, DELTA, 5, 4);
+  EXPECT_EQ(h.sequencer.stats().overflowed, 1u);
+  EXPECT_EQ(h.sequencer.stats().discarded, 0u);
+  // With no retry delay every delta after the gap asks again
+  EXPECT_EQ(h.requests.size(), 3u);
+
+  h.feed(1, SNAPSHOT, 3);
+  EXPECT_EQ(h.appliedSeqs(1), (std::vector<int64_t>{1, 3, 4, 5}));
+  EXPECT_FALSE(h.sequencer.isStale(1));
+}
+
+TEST(BookSequencerTest, SymbolThatNeverRecoversDoesNotStarveOthers)
+{
+  Harness h;
+  h.feed(1, SNAPSHOT, 1);
+  h.feed(2, SNAPSHOT, 1);
+
+  // Symbol 1 never gets its snapshot and keeps buffering far more than the shared pool holds
+  for (int64_t seq = 3; seq < 3 + 2000; ++seq)
+  {
+    h.feed(1, DELTA, seq, seq - 1);
+  }
+  const size_t budget = BookSequencer::BufferPoolSize / 8;
+  EXPECT_EQ(h.sequencer.stats().overflowed, 2000u - budget);
+
+  // Symbol 2 still buffers its own deltas and recovers
+  h.feed(2, DELTA, 3, 2);
+  h.feed(2, DELTA, 4, 3);
+  h.feed(2, SNAPSHOT, 2);
+  EXPECT_FALSE(h.sequencer.isStale(2));
+  EXPECT_TRUE(h.sequencer.isStale(1));
+  EXPECT_EQ(h.appliedSeqs(2), (std::vector<int64_t>{1, 2, 3, 4}));
+  EXPECT_EQ(h.sequencer.stats().overflowed, 2000u - budget);
+}
+
+TEST(BookSequencerTest, OrderBookSetResyncsStaleBook)
+{
+  BookUpdatePool pool;
+  std::vector<SymbolId> requests;
+  OrderBookSet<> books{1, 4, NoHugePages};
+  books.addSymbol(0, Price::fromDouble(0.1));
+  books.addSymbol(1, Price::fromDouble(0.1));
+  books.enableGapRecovery([&](SymbolId s) { requests.push_back(s); });
+
+  books.onBookUpdate(*make(pool, 0, SNAPSHOT, 1, {level(100.0, 1)}, {level(100.1, 1)}));
+  books.onBookUpdate(*make(pool, 1, SNAPSHOT, 1, {level(50.0, 1)}, {level(50.1, 1)}));
+
+  // Symbol 0 misses seq 2; the bid at 100.0 from seq 3 must wait for the snapshot
+  books.onBookUpdate(*make(pool, 0, DELTA, 3, {level(100.0, 3)}, {}, 2));
+  books.onBookUpdate(*make(pool, 1, DELTA, 2, {level(50.0, 2)}, {}, 1));
+  EXPECT_TRUE(books.isStale(0));
+  EXPECT_FALSE(books.isStale(1));
+  EXPECT_EQ(requests, std::vector<SymbolId>{0});
+  EXPECT_EQ(books.find(0)->bidAtPrice(Price::fromDouble(100.0)), Quantity::fromDouble(1));
+  EXPECT_EQ(books.find(1)->bidAtPrice(Price::fromDouble(50.0)), Quantity::fromDouble(2));
+
+  books.onBookUpdate(*make(pool, 0, SNAPSHOT, 2, {level(100.0, 2), level(99.9, 5)}, {level(100.1, 1)}));
+  EXPECT_FALSE(books.isStale(0));
+  EXPECT_EQ(books.find(0)->bidAtPrice(Price::fromDouble(100.0)), Quantity::fromDouble(3));
+  EXPECT_EQ(books.find(0)->bidAtPrice(Price::fromDouble(99.9)), Quantity::fromDouble(5));
+  ASSERT_NE(books.sequencer(), nullptr);
+  EXPECT_EQ(books.sequencer()->stats().recoveries, 1u);
+
+  // Replacing a book forgets its sequence
+  books.addSymbol(0, Price::fromDouble(0.1));
+  books.onBookUpdate(*make(pool, 0, DELTA, 4, {level(100.0, 9)}, {}, 3));
+  EXPECT_TRUE(books.isStale(0));
+}
@@ -0,0 +1,349 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "flox/book/bus/book_update_bus.h"
+#include "flox/book/bus/trade_bus.h"
+#include "flox/execution/bus/order_execution_bus.h"
+#include "flox/util/eventing/bus_journal.h"
+
+#include <unistd.h>
+
+using namespace flox;
+
+namespace
+{
+
+using BookUpdatePool = pool::Pool<BookUpdateEvent, 7>;
+
+class JournalTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    dir = std::filesystem::temp_directory_path() /
+          ("flox_journal_" + std::to_string(::getpid()) + "_" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir); }
+
+  std::filesystem::path dir;
+};
+
+class TradeCounter : public IMarketDataSubscriber
+{
+ public:
+  SubscriberId id() const override { return 1; }
+  void onTrade(const TradeEvent&) override { ++count; }
+  size_t count{0};
+};
+
+// Shares the journal's consumer thread and slows it down enough to be lapped
+class SlowTrades : public IMarketDataSubscriber
+{
+ public:
+  SubscriberId id() const override { return 4; }
+  void onTrade(const TradeEvent&) override { std::this_thread::sleep_for(std::chrono::microseconds(20)); }
+};
+
+TradeEvent makeTrade(uint64_t i)
+{
+  TradeEvent ev;
+  ev.trade.symbol = static_cast<SymbolId>(i % 5);
+  ev.trade.instrument = InstrumentType::Future;
+  ev.trade.isBuy = i % 2 == 0;
+  ev.trade.price = Price::fromDouble(100.0 + static_cast<double>(i));
+  ev.trade.quantity = Quantity::fromRaw(static_cast<int64_t>(i) * 3 + 1);
+  ev.trade.exchangeTsNs = 1'000 + static_cast<int64_t>(i);
+  ev.seq = static_cast<int64_t>(i);
+  ev.trade_id = 10'000 + i;
+  ev.recvNs = 42;
+  ev.publishTsNs = 43 + i;
+  ev.exchangeMsgTsNs = 2'000 + static_cast<int64_t>(i);
+  return ev;
+}
+
+}  // namespace
+
+TEST_F(JournalTest, CodecsRoundTripEveryEventType)
+{
+  {
+    JournalWriter writer(dir, "all");
+
+    journalAppend(writer, makeTrade(7));
+
+    BookUpdatePool pool;
+    auto book = pool.acquire();
+    ASSERT_TRUE(book);
+    (*book)->update.symbol = 3;
+    (*book)->update.type = BookUpdateType::DELTA;
+    (*book)->update.bids = {{Price::fromDouble(99.5), Quantity::fromDouble(2)}};
+    (*book)->update.asks = {{Price::fromDouble(100.5), Quantity::fromDouble(1)},
+                            {Price::fromDouble(101), Quantity::fromDouble(4)}};
+    (*book)->update.strike = Price::fromDouble(120);
+    (*book)->update.optionType = OptionType::PUT;
+    (*book)->seq = 11;
+    (*book)->prevSeq = 10;
+    (*book)->tickSequence = 5;
+    journalAppend(writer, **book);
+
+    CandleEvent candle{.symbol = 2, .candle = Candle(fromFloxNs(1'000), Price::fromDouble(10), Volume::fromDouble(3))};
+    candle.candle.high = Price::fromDouble(12);
+    candle.candle.endTime = fromFloxNs(2'000);
+    journalAppend(writer, candle);
+
+    OrderEvent order{OrderEventStatus::PARTIALLY_FILLED};
+    order.order.id = 77;
+    order.order.side = Side::SELL;
+    order.order.price = Price::fromDouble(50);
+    order.order.quantity = Quantity::fromDouble(2);
+    order.order.symbol = 4;
+    order.order.createdAt = fromFloxNs(123);
+    order.order.expiresAfter = fromFloxNs(456);
+    order.fillQty = Quantity::fromDouble(1);
+    order.publishNs = 99;
+    journalAppend(writer, order);
+
+    writer.commit();
+    EXPECT_EQ(writer.records(), 4u);
+  }
+
+  BookUpdatePool pool;
+  std::vector<JournalRecordType> types;
+  const auto n = JournalReader(dir, "all").forEach(
+      [&](const JournalRecordHeader& rec, std::span<const std::byte> payload)
+      {
+        types.push_back(rec.type);
+        switch (rec.type)
+        {
+          case JournalRecordType::Trade:
+          {
+            TradeEvent ev;
+            JournalCodec<TradeEvent>::decode(rec, payload, ev);
+            const auto want = makeTrade(7);
+            EXPECT_EQ(ev.trade.symbol, want.trade.symbol);
+            EXPECT_EQ(ev.trade.instrument, InstrumentType::Future);
+            EXPECT_EQ(ev.trade.isBuy, want.trade.isBuy);
+            EXPECT_EQ(ev.trade.price, want.trade.price);
+            EXPECT_EQ(ev.trade.quantity, want.trade.quantity);
+            EXPECT_EQ(ev.trade.exchangeTsNs, want.trade.exchangeTsNs);
+            EXPECT_EQ(ev.seq, want.seq);
+            EXPECT_EQ(ev.trade_id, want.trade_id);
+            EXPECT_EQ(ev.recvNs, want.recvNs);
+            EXPECT_EQ(ev.publishTsNs, want.publishTsNs);
+            EXPECT_EQ(ev.exchangeMsgTsNs, want.exchangeMsgTsNs);
+            break;
+          }
+          case JournalRecordType::BookUpdate:
+          {
+            auto h = pool.acquire();
+            ASSERT_TRUE(h);
+            JournalCodec<BookUpdateEvent>::decode(rec, payload, **h);
+            const auto& u = (*h)->update;
+            EXPECT_EQ(u.symbol, 3u);
+            EXPECT_EQ(u.type, BookUpdateType::DELTA);
+            ASSERT_EQ(u.bids.size(), 1u);
+            ASSERT_EQ(u.asks.size(), 2u);
+            EXPECT_EQ(u.bids[0].price, Price::fromDouble(99.5));
+            EXPECT_EQ(u.asks[1].quantity, Quantity::fromDouble(4));
+            EXPECT_EQ(u.strike, Price::fromDouble(120));
+            EXPECT_FALSE(u.expiry.has_value());
+            EXPECT_EQ(u.optionType, OptionType::PUT);
+            EXPECT_EQ((*h)->prevSeq, 10);
+            EXPECT_EQ((*h)->tickSequence, 5u);
+            break;
+          }
+          case JournalRecordType::Candle:
+          {
+            CandleEvent ev;
+            JournalCodec<CandleEvent>::decode(rec, payload, ev);
+            EXPECT_EQ(ev.symbol, 2u);
+            EXPECT_EQ(ev.candle.high, Price::fromDouble(12));
+            EXPECT_EQ(ev.candle.volume, Volume::fromDouble(3));
+            EXPECT_EQ(ev.candle.endTime, fromFloxNs(2'000));
+            break;
+          }
+          case JournalRecordType::Order:
+          {
+            OrderEvent ev;
+            JournalCodec<OrderEvent>::decode(rec, payload, ev);
+            EXPECT_EQ(ev.status, OrderEventStatus::PARTIALLY_FILLED);
+            EXPECT_EQ(ev.order.id, 77u);
+            EXPECT_EQ(ev.order.side, Side::SELL);
+            EXPECT_EQ(ev.order.symbol, 4u);
+            EXPECT_EQ(ev.order.createdAt, fromFloxNs(123));
+            EXPECT_EQ(ev.order.expiresAfter, fromFloxNs(456));
+            EXPECT_FALSE(ev.order.lastUpdated.has_value());
+            EXPECT_EQ(ev.fillQty, Quantity::fromDouble(1));
+            EXPECT_EQ(ev.publishNs, 99u);
+            break;
+          }
+        }
+      });
+
+  EXPECT_EQ(n, 4u);
+  EXPECT_EQ(types, (std::vector{JournalRecordType::Trade, JournalRecordType::BookUpdate,
+                                JournalRecordType::Candle, JournalRecordType::Order}));
+}
+
+TEST_F(JournalTest, RollsSegmentsAndNeverOverwrites)
+{
+  for (int run = 0; run < 2; ++run)
+  {
+    JournalWriter writer(dir, "trades", 4096);
+    for (uint64_t i = 0; i < 200; ++i)
+    {
+      journalAppend(writer, makeTrade(run * 200 + i));
+      if (i % 16 == 15)
+      {
+        writer.commit();
+      }
+    }
+    writer.commit();
+    EXPECT_GT(writer.segments(), 1u);
+  }
+
+  std::vector<uint64_t> ids;
+  JournalReader(dir, "trades").forEach([&](const JournalRecordHeader& rec, std::span<const std::byte> payload)
+                                       {
+    TradeEvent ev;
+    JournalCodec<TradeEvent>::decode(rec, payload, ev);
+    ids.push_back(ev.trade_id); });
+
+  ASSERT_EQ(ids.size(), 400u);
+  for (uint64_t i = 0; i < 400; ++i)
+  {
+    EXPECT_EQ(ids[i], 10'000 + i);
+  }
+}
+
+TEST_F(JournalTest, UncommittedRecordsAreInvisible)
+{
+  JournalWriter writer(dir, "partial");
+  journalAppend(writer, makeTrade(0));
+  writer.commit();
+  journalAppend(writer, makeTrade(1));
+
+  EXPECT_EQ(JournalReader(dir, "partial").forEach([](const auto&, auto) {}), 1u);
+  writer.commit();
+  EXPECT_EQ(JournalReader(dir, "partial").forEach([](const auto&, auto) {}), 2u);
+}
+
+TEST_F(JournalTest, OptionalConsumerJournalsTradeBus)
+{
+  {
+    TradeBus bus;
+    TradeCounter counter;
+    MarketDataJournal journal(2, dir, "trade_bus");
+    bus.subscribe(&counter);
+    bus.subscribe(&journal, false);
+    bus.enableDrainOnStop();
+    bus.start();
+
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+      bus.publish(makeTrade(i));
+    }
+    bus.flush();
+    bus.stop();
+
+    EXPECT_EQ(counter.count, 1000u);
+    EXPECT_EQ(journal.writer().records(), 1000u);
+  }
+
+  uint64_t expected = 0;
+  JournalReader(dir, "trade_bus").forEach([&](const JournalRecordHeader& rec, std::span<const std::byte> payload)
+                                          {
+    TradeEvent ev;
+    JournalCodec<TradeEvent>::decode(rec, payload, ev);
+    EXPECT_EQ(rec.tickSequence, expected);
+    EXPECT_EQ(ev.trade_id, 10'000 + expected);
+    EXPECT_EQ(rec.publishNs, static_cast<int64_t>(43 + expected));
+    ++expected; });
+  EXPECT_EQ(expected, 1000u);
+}
+
+TEST_F(JournalTest, LappedJournalSkipsAheadAndKeepsRecording)
+{
+  constexpr uint64_t Count = 5000;
+  uint64_t lost = 0;
+  {
+    TradeBus bus{EventBusConfig{.capacity = 64}};
+    TradeCounter counter;
+    SlowTrades slow;
+    MarketDataJournal journal(2, dir, "lapped");
+    bus.subscribe(&counter);
+    bus.subscribe(&slow, false);
+    bus.subscribe(&journal, TradeBus::ConsumerOptions{.group = &slow});
+    bus.enableDrainOnStop();
+    bus.start();
+
+    for (uint64_t i = 0; i < Count; ++i)
+    {
+      bus.publish(makeTrade(i));
+    }
+    bus.flush();
+    bus.stop();
+
+    EXPECT_EQ(counter.count, Count);
+    lost = bus.stats().consumers[1].lost;
+    EXPECT_GT(lost, 0u);
+    EXPECT_EQ(journal.writer().records() + lost, Count);
+  }
+
+  // Records stay in order with gaps where the journal was lapped, up to the last event
+  uint64_t records = 0;
+  int64_t previous = -1;
+  JournalReader(dir, "lapped").forEach([&](const JournalRecordHeader& rec, std::span<const std::byte> payload)
+                                       {
+    TradeEvent ev;
+    JournalCodec<TradeEvent>::decode(rec, payload, ev);
+    EXPECT_GT(static_cast<int64_t>(rec.tickSequence), previous);
+    EXPECT_EQ(ev.trade_id, 10'000 + rec.tickSequence);
+    previous = static_cast<int64_t>(rec.tickSequence);
+    ++records; });
+  EXPECT_EQ(records + lost, Count);
+  EXPECT_EQ(previous, static_cast<int64_t>(Count - 1));
+}
+
+TEST_F(JournalTest, OrderJournalRecordsRawEvents)
+{
+  {
+    OrderExecutionBus bus;
+    OrderEventJournal journal(3, dir, "orders");
+    bus.subscribe(&journal, false);
+    bus.enableDrainOnStop();
+    bus.start();
+
+    Order order{.id = 1, .quantity = Quantity::fromDouble(2)};
+    bus.emplace(OrderEventStatus::ACCEPTED, order);
+    bus.emplace(OrderEventStatus::PARTIALLY_FILLED, order, Order{}, Quantity::fromDouble(1));
+    bus.emplace(OrderEventStatus::FILLED, order, Order{}, Quantity::fromDouble(1));
+    bus.stop();
+  }
+
+  std::vector<OrderEventStatus> statuses;
+  JournalReader(dir, "orders").forEach([&](const JournalRecordHeader& rec, std::span<const std::byte> payload)
+                                       {
+    OrderEvent ev;
+    JournalCodec<OrderEvent>::decode(rec, payload, ev);
+    EXPECT_EQ(rec.tickSequence, statuses.size());
+    EXPECT_EQ(ev.order.id, 1u);
+    statuses.push_back(ev.status); });
+
+  EXPECT_EQ(statuses, (std::vector{OrderEventStatus::ACCEPTED, OrderEventStatus::PARTIALLY_FILLED,
+                                   OrderEventStatus::FILLED}));
+}
@@ -0,0 +1,170 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "flox/book/bus/book_update_bus.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+
+using namespace flox;
+
+namespace
+{
+
+using BookUpdatePool = pool::Pool<BookUpdateEvent, 63>;
+
+class LatestSubscriber : public IMarketDataSubscriber
+{
+ public:
+  void onConflatedBookUpdate(const BookUpdateEvent& ev, uint64_t skipped) override
+  {
+    if (gate)
+    {
+      entered.store(true);
+      while (!release.load())
+      {
+        std::this_thread::yield();
+      }
+      gate = false;
+    }
+    latest[ev.update.symbol] = ev.seq;
+    skippedTotal += skipped;
+    ++calls;
+  }
+
+  SubscriberId id() const override { return 1; }
+
+  bool gate{false};
+  std::atomic<bool> entered{false};
+  std::atomic<bool> release{false};
+  std::map<SymbolId, int64_t> latest;
+  uint64_t skippedTotal{0};
+  uint64_t calls{0};
+};
+
+pool::Handle<BookUpdateEvent> makeUpdate(BookUpdatePool& pool, SymbolId symbol, int64_t seq)
+{
+  auto h = pool.acquire();
+  EXPECT_TRUE(h.has_value());
+  (*h)->update.symbol = symbol;
+  (*h)->update.type = BookUpdateType::SNAPSHOT;
+  (*h)->seq = seq;
+  return std::move(*h);
+}
+
+}  // namespace
+
+TEST(ConflatingEventBusTest, DeliversEveryUpdateWhenConsumerKeepsUp)
+{
+  BookUpdatePool pool;  // outlives the bus, which holds the latest handles
+  ConflatingBookUpdateBus bus(16);
+  LatestSubscriber sub;
+  bus.subscribe(&sub);
+  bus.start();
+
+  for (int64_t seq = 1; seq <= 5; ++seq)
+  {
+    bus.publish(makeUpdate(pool, 3, seq));
+    bus.flush();
+  }
+  bus.stop();
+
+  EXPECT_EQ(sub.calls, 5u);
+  EXPECT_EQ(sub.skippedTotal, 0u);
+  EXPECT_EQ(sub.latest[3], 5);
+}
+
+TEST(ConflatingEventBusTest, StalledConsumerSeesLatestVersionOncePerSymbol)
+{
+  BookUpdatePool pool;
+  ConflatingBookUpdateBus bus(200);
+  LatestSubscriber sub;
+  sub.gate = true;
+  bus.subscribe(&sub);
+  bus.start();
+
+  bus.publish(makeUpdate(pool, 0, 0));
+  while (!sub.entered.load())
+  {
+    std::this_thread::yield();
+  }
+
+  // A burst over three symbols while the consumer is stuck; the pool holds only the latest
+  int64_t seq = 1;
+  for (int round = 0; round < 40; ++round)
+  {
+    for (SymbolId s : {SymbolId{1}, SymbolId{70}, SymbolId{150}})
+    {
+      bus.publish(makeUpdate(pool, s, seq++));
+    }
+  }
+
+  sub.release.store(true);
+  bus.flush();
+  const auto stats = bus.stats();
+  bus.stop();
+
+  EXPECT_EQ(sub.calls, 4u);
+  EXPECT_EQ(sub.skippedTotal, 117u);
+  EXPECT_EQ(sub.latest[1], seq - 3);
+  EXPECT_EQ(sub.latest[70], seq - 2);
+  EXPECT_EQ(sub.latest[150], seq - 1);
+
+  EXPECT_EQ(stats.published, 121u);
+  ASSERT_EQ(stats.consumers.size(), 1u);
+  EXPECT_EQ(stats.consumers[0].delivered, 4u);
+  EXPECT_EQ(stats.consumers[0].conflated, 117u);
+}
+
+TEST(ConflatingEventBusTest, OutOfRangeSymbolIsRejected)
+{
+  BookUpdatePool pool;
+  ConflatingBookUpdateBus bus(16);
+  LatestSubscriber sub;
+  bus.subscribe(&sub);
+  bus.start();
+
+  bus.publish(makeUpdate(pool, 16, 1));
+  bus.publish(makeUpdate(pool, 1000, 2));
+  bus.publish(makeUpdate(pool, 15, 3));
+  bus.flush();
+  const auto stats = bus.stats();
+  bus.stop();
+
+  EXPECT_EQ(stats.rejected, 2u);
+  EXPECT_EQ(stats.published, 1u);
+  EXPECT_EQ(sub.calls, 1u);
+  EXPECT_EQ(sub.latest[15], 3);
+  EXPECT_EQ(sub.latest.count(16), 0u);
+}
+
+TEST(ConflatingEventBusTest, LateSubscriberStartsFromCurrentState)
+{
+  BookUpdatePool pool;
+  ConflatingBookUpdateBus bus(8);
+  bus.publish(makeUpdate(pool, 2, 1));
+  bus.publish(makeUpdate(pool, 2, 2));
+  bus.publish(makeUpdate(pool, 5, 3));
+
+  LatestSubscriber sub;
+  bus.subscribe(&sub);
+  bus.start();
+  bus.flush();
+  bus.stop();
+
+  EXPECT_EQ(sub.calls, 2u);
+  EXPECT_EQ(sub.latest[2], 2);
+  EXPECT_EQ(sub.latest[5], 3);
+  EXPECT_EQ(sub.skippedTotal, 1u);
+}
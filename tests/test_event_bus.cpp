@@ -0,0 +1,1141 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/events/trade_event.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+#include "flox/util/eventing/event_bus.h"
+#include "flox/util/eventing/partitioned_event_bus.h"
+#include "flox/util/memory/pool.h"
+
+using namespace flox;
+
+namespace
+{
+
+template <typename Bus>
+class EventBusTest : public ::testing::Test
+{
+};
+
+using BusTypes = ::testing::Types<EventBus<TradeEvent, 8, 4, MultiProducer>,
+                                  EventBus<TradeEvent, 8, 4, SingleProducer>>;
+TYPED_TEST_SUITE(EventBusTest, BusTypes);
+
+class RecordingSubscriber : public IMarketDataSubscriber
+{
+ public:
+  explicit RecordingSubscriber(SubscriberId id) : _id(id) {}
+
+  void onTrade(const TradeEvent& ev) override
+  {
+    ids.push_back(ev.trade_id);
+    ticks.push_back(ev.tickSequence);
+  }
+
+  void onBookUpdate(const BookUpdateEvent& ev) override { ids.push_back(static_cast<uint64_t>(ev.seq)); }
+
+  SubscriberId id() const override { return _id; }
+
+  std::vector<uint64_t> ids;
+  std::vector<uint64_t> ticks;
+
+ private:
+  SubscriberId _id;
+};
+
+// Holds the consumer thread inside the first event until released, so later events pile up
+class BatchingSubscriber : public IMarketDataSubscriber
+{
+ public:
+  void onTrade(const TradeEvent& ev) override
+  {
+    if (ids.empty())
+    {
+      entered.store(true);
+      while (!release.load())
+      {
+        std::this_thread::yield();
+      }
+    }
+    ids.push_back(ev.trade_id);
+  }
+
+  bool onTradeBatch(std::span<const TradeEvent> batch) override
+  {
+    batchSizes.push_back(batch.size());
+    for (const auto& ev : batch)
+    {
+      ids.push_back(ev.trade_id);
+    }
+    return true;
+  }
+
+  SubscriberId id() const override { return 3; }
+
+  std::atomic<bool> entered{false};
+  std::atomic<bool> release{false};
+  std::vector<uint64_t> ids;
+  std::vector<size_t> batchSizes;
+};
+
+// Pipeline stage: records what it sees and whether any upstream was still behind
+class StageSubscriber : public IMarketDataSubscriber
+{
+ public:
+  explicit StageSubscriber(SubscriberId id, std::vector<const StageSubscriber*> upstream = {})
+      : _id(id), _upstream(std::move(upstream))
+  {
+  }
+
+  void onTrade(const TradeEvent& ev) override
+  {
+    for (const auto* u : _upstream)
+    {
+      if (u->done.load(std::memory_order_acquire) < static_cast<int64_t>(ev.trade_id))
+      {
+        violations.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (ev.trade_id % 7 == 0)
+    {
+      std::this_thread::yield();
+    }
+    ids.push_back(ev.trade_id);
+    done.store(static_cast<int64_t>(ev.trade_id), std::memory_order_release);
+  }
+
+  SubscriberId id() const override { return _id; }
+
+  std::atomic<int64_t> done{-1};
+  std::atomic<int> violations{0};
+  std::vector<uint64_t> ids;
+
+ private:
+  SubscriberId _id;
+  std::vector<const StageSubscriber*> _upstream;
+};
+
+// Remembers which threads delivered its events
+class ThreadRecordingSubscriber : public IMarketDataSubscriber
+{
+ public:
+  explicit ThreadRecordingSubscriber(SubscriberId id) : _id(id) {}
+
+  void onTrade(const TradeEvent& ev) override
+  {
+    ids.push_back(ev.trade_id);
+    if (std::find(threads.begin(), threads.end(), std::this_thread::get_id()) == threads.end())
+    {
+      threads.push_back(std::this_thread::get_id());
+    }
+  }
+
+  SubscriberId id() const override { return _id; }
+
+  std::vector<uint64_t> ids;
+  std::vector<std::thread::id> threads;
+
+ private:
+  SubscriberId _id;
+};
+
+class TrackedListener;
+
+// Its destructor clears `state`, so a consumer handed a destroyed slot can tell
+struct TrackedEvent
+{
+  using Listener = TrackedListener;
+  static constexpr uint64_t Live = 0x5eed;
+
+  explicit TrackedEvent(uint64_t i) : id(i) {}
+  TrackedEvent(const TrackedEvent& other) : id(other.id) {}
+  ~TrackedEvent() { state.store(0, std::memory_order_relaxed); }
+
+  uint64_t id{0};
+  std::atomic<uint64_t> state{Live};
+};
+
+class TrackedListener
+{
+ public:
+  explicit TrackedListener(std::chrono::microseconds delay = {}) : _delay(delay) {}
+
+  // Lets the publisher run ahead of a fast consumer every so often
+  bool yieldEvery64{false};
+
+  void onTracked(const TrackedEvent& ev)
+  {
+    if (ev.state.load(std::memory_order_relaxed) != TrackedEvent::Live)
+    {
+      ++destroyed;
+    }
+    else if (!ids.empty() && ev.id <= ids.back())
+    {
+      ++outOfOrder;
+    }
+    ids.push_back(ev.id);
+    if (_delay.count() > 0)
+    {
+      std::this_thread::sleep_for(_delay);
+    }
+    else if (yieldEvery64 && ev.id % 64 == 0)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  std::vector<uint64_t> ids;
+  size_t destroyed{0};
+  size_t outOfOrder{0};
+
+ private:
+  std::chrono::microseconds _delay;
+};
+
+std::vector<TradeEvent> makeTrades(size_t n, uint64_t firstId = 0)
+{
+  std::vector<TradeEvent> trades(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    trades[i].trade_id = firstId + i;
+    trades[i].trade.symbol = 1;
+    trades[i].trade.price = Price::fromDouble(100.0);
+  }
+  return trades;
+}
+
+}  // namespace
+
+template <>
+struct flox::EventDispatcher<TrackedEvent>
+{
+  static void dispatch(const TrackedEvent& ev, TrackedListener& listener) { listener.onTracked(ev); }
+};
+
+namespace
+{
+
+// A fast required consumer next to an optional one that is lapped over and over
+template <typename Policy>
+void publishPastLaggingOptionalConsumer()
+{
+  using Bus = EventBus<TrackedEvent, 64, 4, Policy>;
+  constexpr uint64_t Count = 200000;
+
+  auto bus = std::make_unique<Bus>();
+  TrackedListener fast;
+  TrackedListener slow{std::chrono::microseconds{20}};
+  fast.yieldEvery64 = true;
+  bus->subscribe(&fast);
+  bus->subscribe(&slow, false);
+  bus->start();
+
+  for (uint64_t i = 0; i < Count; ++i)
+  {
+    bus->emplace(i);
+  }
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(fast.ids.size(), Count);
+  EXPECT_EQ(fast.destroyed, 0u);
+  EXPECT_EQ(fast.outOfOrder, 0u);
+  EXPECT_EQ(fast.ids.back(), Count - 1);
+}
+
+}  // namespace
+
+TYPED_TEST(EventBusTest, PublishBatchDeliversInOrder)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber sub(1);
+  bus->subscribe(&sub);
+  bus->start();
+
+  const auto trades = makeTrades(5);
+  const int64_t last = bus->publishBatch(trades);
+  EXPECT_EQ(last, 4);
+
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(sub.ids.size(), 5u);
+  for (uint64_t i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(sub.ids[i], i);
+    EXPECT_EQ(sub.ticks[i], i);
+  }
+}
+
+TYPED_TEST(EventBusTest, PublishBatchLargerThanRingIsChunked)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber sub(1);
+  bus->subscribe(&sub);
+  bus->start();
+
+  const auto trades = makeTrades(37);
+  const int64_t last = bus->publishBatch(trades);
+  EXPECT_EQ(last, 36);
+
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(sub.ids.size(), 37u);
+  for (uint64_t i = 0; i < 37; ++i)
+  {
+    EXPECT_EQ(sub.ids[i], i);
+  }
+}
+
+TYPED_TEST(EventBusTest, EmptyBatchPublishesNothing)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber sub(1);
+  bus->subscribe(&sub);
+  bus->start();
+
+  EXPECT_EQ(bus->publishBatch({}), -1);
+
+  bus->stop();
+  EXPECT_TRUE(sub.ids.empty());
+}
+
+TYPED_TEST(EventBusTest, ClaimBuildsEventsInPlace)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber sub(1);
+  bus->subscribe(&sub);
+  bus->start();
+
+  for (int round = 0; round < 10; ++round)
+  {
+    const auto claim = bus->claim(3);
+    ASSERT_EQ(claim.size(), 3u);
+    for (int64_t s = claim.first; s <= claim.last; ++s)
+    {
+      auto& ev = bus->emplaceAt(s);
+      ev.trade_id = static_cast<uint64_t>(s) * 10;
+    }
+    bus->commit(claim);
+  }
+
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(sub.ids.size(), 30u);
+  for (uint64_t i = 0; i < 30; ++i)
+  {
+    EXPECT_EQ(sub.ids[i], i * 10);
+  }
+}
+
+TYPED_TEST(EventBusTest, EmplaceConstructsFromArguments)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber sub(1);
+  bus->subscribe(&sub);
+  bus->start();
+
+  for (uint64_t i = 0; i < 20; ++i)
+  {
+    EXPECT_EQ(bus->emplace(Trade{}, 0, i * 7), static_cast<int64_t>(i));
+  }
+  bus->flush();
+  EXPECT_EQ(bus->tryEmplace(Trade{}, 0, uint64_t{140}), 20);
+
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(sub.ids.size(), 21u);
+  for (uint64_t i = 0; i < 21; ++i)
+  {
+    EXPECT_EQ(sub.ids[i], i * 7);
+  }
+}
+
+TYPED_TEST(EventBusTest, BatchesInterleaveWithSinglePublishes)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber a(1), b(2);
+  bus->subscribe(&a);
+  bus->subscribe(&b);
+  bus->start();
+
+  uint64_t id = 0;
+  for (int round = 0; round < 20; ++round)
+  {
+    const auto trades = makeTrades(4, id);
+    bus->publishBatch(trades);
+    id += 4;
+
+    TradeEvent single;
+    single.trade_id = id++;
+    bus->publish(single);
+  }
+
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(a.ids.size(), id);
+  ASSERT_EQ(b.ids.size(), id);
+  for (uint64_t i = 0; i < id; ++i)
+  {
+    EXPECT_EQ(a.ids[i], i);
+    EXPECT_EQ(b.ids[i], i);
+  }
+}
+
+TEST(SingleProducerEventBusTest, PooledEventsAreReleased)
+{
+  using Bus = EventBus<pool::Handle<BookUpdateEvent>, 8, 4, SingleProducer>;
+  pool::Pool<BookUpdateEvent, 15> pool;
+
+  auto bus = std::make_unique<Bus>();
+  RecordingSubscriber sub(1);
+  bus->subscribe(&sub);
+  bus->start();
+
+  for (int64_t i = 0; i < 100; ++i)
+  {
+    auto h = pool.acquire();
+    ASSERT_TRUE(h.has_value());
+    (*h)->seq = i;
+    bus->publish(std::move(*h));
+  }
+
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(sub.ids.size(), 100u);
+  EXPECT_EQ(sub.ids.back(), 99u);
+  EXPECT_EQ(pool.inUse(), 0u);
+}
+
+TEST(SingleProducerEventBusTest, OptionalConsumerSeesEvents)
+{
+  using Bus = EventBus<TradeEvent, 8, 4, SingleProducer>;
+
+  auto bus = std::make_unique<Bus>();
+  RecordingSubscriber required(1), optional(2);
+  bus->subscribe(&required);
+  bus->subscribe(&optional, false);
+  bus->enableDrainOnStop();
+  bus->start();
+
+  const auto trades = makeTrades(6);
+  bus->publishBatch(trades);
+  bus->flush();
+  bus->stop();
+
+  EXPECT_EQ(required.ids.size(), 6u);
+  EXPECT_EQ(optional.ids.size(), 6u);
+}
+
+TEST(EventBusReclaimTest, LappedOptionalConsumerNeverExposesDestroyedEvents)
+{
+  publishPastLaggingOptionalConsumer<MultiProducer>();
+  publishPastLaggingOptionalConsumer<SingleProducer>();
+}
+
+TYPED_TEST(EventBusTest, BacklogIsDeliveredAsBatch)
+{
+  auto bus = std::make_unique<TypeParam>();
+  BatchingSubscriber sub;
+  bus->subscribe(&sub);
+  bus->start();
+
+  TradeEvent first;
+  first.trade_id = 0;
+  bus->publish(first);
+  while (!sub.entered.load())
+  {
+    std::this_thread::yield();
+  }
+
+  const auto trades = makeTrades(5, 1);
+  bus->publishBatch(trades);
+  sub.release.store(true);
+
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(sub.ids.size(), 6u);
+  for (uint64_t i = 0; i < 6; ++i)
+  {
+    EXPECT_EQ(sub.ids[i], i);
+  }
+
+  // Five backlogged events on an 8-slot ring: one span, or two if the run wraps
+  ASSERT_FALSE(sub.batchSizes.empty());
+  size_t batched = 0;
+  for (size_t n : sub.batchSizes)
+  {
+    batched += n;
+  }
+  EXPECT_EQ(batched, 5u);
+  EXPECT_LE(sub.batchSizes.size(), 2u);
+}
+
+TEST(EventBusWaitStrategyTest, EveryStrategyDeliversIdleGaps)
+{
+  using namespace std::chrono_literals;
+
+  const WaitStrategy strategies[] = {WaitStrategy::busySpin(), WaitStrategy::spinYield(),
+                                     WaitStrategy::park(16), WaitStrategy::timedPark(200us, 16)};
+
+  for (const auto& strategy : strategies)
+  {
+    auto bus = std::make_unique<EventBus<TradeEvent, 8, 4>>();
+    bus->setWaitStrategy(strategy);
+    RecordingSubscriber sub(1);
+    bus->subscribe(&sub);
+    bus->start();
+
+    for (uint64_t i = 0; i < 4; ++i)
+    {
+      // Long enough for parking consumers to fall asleep between events
+      std::this_thread::sleep_for(5ms);
+      TradeEvent ev;
+      ev.trade_id = i;
+      bus->waitConsumed(bus->publish(ev));
+    }
+
+    bus->stop();
+
+    ASSERT_EQ(sub.ids.size(), 4u);
+    EXPECT_EQ(sub.ids.back(), 3u);
+  }
+}
+
+TEST(EventBusWaitStrategyTest, StopWakesParkedConsumers)
+{
+  using namespace std::chrono_literals;
+
+  auto bus = std::make_unique<EventBus<TradeEvent, 8, 4>>();
+  bus->setWaitStrategy(WaitStrategy::park(16));
+  RecordingSubscriber a(1), b(2);
+  bus->subscribe(&a);
+  bus->subscribe(&b, {.required = true, .waitStrategy = WaitStrategy::timedPark(1s, 16)});
+  bus->start();
+
+  std::this_thread::sleep_for(10ms);
+
+  const auto t0 = std::chrono::steady_clock::now();
+  bus->stop();
+  EXPECT_LT(std::chrono::steady_clock::now() - t0, 500ms);
+}
+
+TEST(EventBusWaitStrategyTest, PerConsumerStrategyOverridesBusDefault)
+{
+  using namespace std::chrono_literals;
+
+  auto bus = std::make_unique<EventBus<TradeEvent, 8, 4>>();
+  bus->setWaitStrategy(WaitStrategy::park(16));
+  RecordingSubscriber parked(1), spinning(2);
+  bus->subscribe(&parked);
+  bus->subscribe(&spinning, {.required = true, .waitStrategy = WaitStrategy::busySpin()});
+  bus->start();
+
+  std::this_thread::sleep_for(5ms);
+  const auto trades = makeTrades(20);
+  bus->publishBatch(trades);
+  bus->flush();
+  bus->stop();
+
+  EXPECT_EQ(parked.ids.size(), 20u);
+  EXPECT_EQ(spinning.ids.size(), 20u);
+}
+
+TYPED_TEST(EventBusTest, DependentConsumerTrailsItsUpstreams)
+{
+  auto bus = std::make_unique<TypeParam>();
+  StageSubscriber decode(1), risk(2);
+  StageSubscriber strategy(3, {&decode, &risk});
+  bus->subscribe(&decode);
+  bus->subscribe(&risk);
+  bus->subscribe(&strategy, {.dependsOn = {&decode, &risk}});
+  bus->start();
+
+  const auto trades = makeTrades(200);
+  bus->publishBatch(trades);
+  bus->flush();
+  bus->stop();
+
+  EXPECT_EQ(strategy.violations.load(), 0);
+  ASSERT_EQ(strategy.ids.size(), 200u);
+  for (uint64_t i = 0; i < 200; ++i)
+  {
+    EXPECT_EQ(strategy.ids[i], i);
+  }
+}
+
+TEST(EventBusDependencyTest, ParkedPipelineDrainsOnStop)
+{
+  using namespace std::chrono_literals;
+
+  auto bus = std::make_unique<EventBus<TradeEvent, 8, 4>>();
+  bus->setWaitStrategy(WaitStrategy::park(16));
+  StageSubscriber first(1);
+  StageSubscriber second(2, {&first});
+  StageSubscriber third(3, {&second});
+  bus->subscribe(&first);
+  bus->subscribe(&second, {.dependsOn = {&first}});
+  bus->subscribe(&third, {.dependsOn = {&second}});
+  bus->enableDrainOnStop();
+  bus->start();
+
+  // Idle gaps let every stage park between events
+  for (uint64_t i = 0; i < 4; ++i)
+  {
+    std::this_thread::sleep_for(5ms);
+    TradeEvent ev;
+    ev.trade_id = i;
+    bus->publish(ev);
+  }
+  bus->publishBatch(makeTrades(40, 4));
+  bus->stop();
+
+  EXPECT_EQ(second.violations.load(), 0);
+  EXPECT_EQ(third.violations.load(), 0);
+  EXPECT_EQ(first.ids.size(), 44u);
+  EXPECT_EQ(second.ids.size(), 44u);
+  EXPECT_EQ(third.ids.size(), 44u);
+}
+
+TYPED_TEST(EventBusTest, SymbolFilterSkipsOtherSymbols)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber all(1), one(2), pair(3);
+  bus->subscribe(&all);
+  bus->subscribe(&one, SymbolFilter{1});
+  bus->subscribe(&pair, {.waitStrategy = WaitStrategy::busySpin(), .symbols = SymbolFilter{2, 300}});
+  bus->start();
+
+  auto trades = makeTrades(30);
+  const SymbolId symbols[] = {1, 2, 300, 7, 1};
+  for (size_t i = 0; i < trades.size(); ++i)
+  {
+    trades[i].trade.symbol = symbols[i % 5];
+  }
+  bus->publishBatch(trades);
+  bus->flush();
+  bus->stop();
+
+  EXPECT_EQ(all.ids.size(), 30u);
+  ASSERT_EQ(one.ids.size(), 12u);
+  ASSERT_EQ(pair.ids.size(), 12u);
+  for (uint64_t id : one.ids)
+  {
+    EXPECT_EQ(symbols[id % 5], 1u);
+  }
+  for (uint64_t id : pair.ids)
+  {
+    EXPECT_TRUE(symbols[id % 5] == 2 || symbols[id % 5] == 300);
+  }
+}
+
+TEST(PartitionedEventBusTest, RoutesEachSymbolToOneShard)
+{
+  PartitionedEventBus<TradeEvent, 4, 8, 4> bus;
+  RecordingSubscriber s1(1), s6(2);
+  bus.subscribe(&s1, SymbolFilter{1});
+  bus.subscribe(&s6, SymbolFilter{6});
+  bus.start();
+
+  for (uint64_t i = 0; i < 40; ++i)
+  {
+    TradeEvent ev;
+    ev.trade_id = i;
+    ev.trade.symbol = static_cast<SymbolId>(i % 8);
+    bus.publish(ev);
+  }
+  bus.flush();
+  bus.stop();
+
+  EXPECT_EQ(bus.shard(PartitionedEventBus<TradeEvent, 4, 8, 4>::shardOf(1)).consumerCount(), 1u);
+  EXPECT_EQ(bus.shard(0).consumerCount(), 0u);
+
+  ASSERT_EQ(s1.ids.size(), 5u);
+  ASSERT_EQ(s6.ids.size(), 5u);
+  for (size_t i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(s1.ids[i], 1 + i * 8);
+    EXPECT_EQ(s6.ids[i], 6 + i * 8);
+  }
+}
+
+TEST(PartitionedEventBusTest, ListenerOnSeveralShardsIsCalledConcurrently)
+{
+  // Holds the first symbol-0 callback until a symbol-1 callback arrives, which only
+  // another shard's thread can deliver
+  class Overlapping : public IMarketDataSubscriber
+  {
+   public:
+    void onTrade(const TradeEvent& ev) override
+    {
+      if (ev.trade.symbol == 1)
+      {
+        sawSymbol1.store(true);
+        return;
+      }
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (!sawSymbol1.load() && std::chrono::steady_clock::now() < deadline)
+      {
+        std::this_thread::yield();
+      }
+      overlapped.store(sawSymbol1.load());
+    }
+    SubscriberId id() const override { return 1; }
+
+    std::atomic<bool> sawSymbol1{false};
+    std::atomic<bool> overlapped{false};
+  };
+
+  PartitionedEventBus<TradeEvent, 2, 8, 4> bus;
+  Overlapping sub;
+  bus.subscribe(&sub, SymbolFilter{0, 1});
+  EXPECT_EQ(bus.shard(0).consumerCount(), 1u);
+  EXPECT_EQ(bus.shard(1).consumerCount(), 1u);
+  bus.start();
+
+  TradeEvent ev;
+  ev.trade.symbol = 0;
+  bus.publish(ev);
+  ev.trade.symbol = 1;
+  bus.publish(ev);
+  bus.flush();
+  bus.stop();
+
+  EXPECT_TRUE(sub.overlapped.load());
+}
+
+TEST(PartitionedEventBusTest, EmptyFilterIsRejected)
+{
+  PartitionedEventBus<TradeEvent, 2, 8, 4> bus;
+  RecordingSubscriber sub(1);
+  EXPECT_THROW(bus.subscribe(&sub, SymbolFilter{}), std::invalid_argument);
+  EXPECT_EQ(bus.shard(0).consumerCount(), 0u);
+  EXPECT_EQ(bus.shard(1).consumerCount(), 0u);
+}
+
+TYPED_TEST(EventBusTest, SubscribeWhileRunningStartsAtCursor)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber early(1), late(2);
+  bus->subscribe(&early);
+  bus->start();
+
+  bus->publishBatch(makeTrades(10));
+  bus->flush();
+
+  bus->subscribe(&late);
+  EXPECT_EQ(bus->consumerCount(), 2u);
+  bus->publishBatch(makeTrades(20, 10));
+  bus->flush();
+  bus->stop();
+
+  EXPECT_EQ(early.ids.size(), 30u);
+  ASSERT_EQ(late.ids.size(), 20u);
+  for (uint64_t i = 0; i < 20; ++i)
+  {
+    EXPECT_EQ(late.ids[i], 10 + i);
+  }
+}
+
+TYPED_TEST(EventBusTest, UnsubscribingConsumerStopsGatingAtOnce)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber steady(1);
+  BatchingSubscriber stuck;
+  bus->subscribe(&steady);
+  bus->subscribe(&stuck);
+  bus->start();
+
+  TradeEvent first;
+  first.trade_id = 0;
+  bus->publish(first);
+  while (!stuck.entered.load())
+  {
+    std::this_thread::yield();
+  }
+
+  // The consumer is parked inside a callback; unsubscribe waits for it to return
+  std::thread leaving([&]
+                      { EXPECT_TRUE(bus->unsubscribe(&stuck)); });
+  while (bus->consumerCount() != 1)
+  {
+    std::this_thread::yield();
+  }
+
+  // Several ring lengths go through although the departing consumer never advanced
+  bus->publishBatch(makeTrades(40, 1));
+  bus->flush();
+
+  stuck.release.store(true);
+  leaving.join();
+  EXPECT_FALSE(bus->unsubscribe(&stuck));
+  bus->stop();
+
+  EXPECT_EQ(steady.ids.size(), 41u);
+  EXPECT_EQ(stuck.ids.size(), 1u);
+}
+
+TYPED_TEST(EventBusTest, UpstreamGatesAgainAfterDependentLeaves)
+{
+  auto bus = std::make_unique<TypeParam>();
+  StageSubscriber upstream(1);
+  StageSubscriber downstream(2, {&upstream});
+  bus->subscribe(&upstream);
+  bus->subscribe(&downstream, {.dependsOn = {&upstream}});
+  bus->start();
+
+  bus->publishBatch(makeTrades(20));
+  bus->flush();
+  EXPECT_TRUE(bus->unsubscribe(&downstream));
+
+  // The upstream is the only consumer left and must not be lapped
+  bus->publishBatch(makeTrades(200, 20));
+  bus->flush();
+
+  RecordingSubscriber reuse(3);
+  bus->subscribe(&reuse);
+  bus->publishBatch(makeTrades(5, 220));
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(upstream.ids.size(), 225u);
+  for (uint64_t i = 0; i < 225; ++i)
+  {
+    EXPECT_EQ(upstream.ids[i], i);
+  }
+  EXPECT_EQ(downstream.ids.size(), 20u);
+  EXPECT_EQ(reuse.ids.size(), 5u);
+}
+
+TYPED_TEST(EventBusTest, RestartResumesAfterLastSequence)
+{
+  auto bus = std::make_unique<TypeParam>();
+  RecordingSubscriber sub(1);
+  bus->subscribe(&sub);
+  bus->start();
+  bus->publishBatch(makeTrades(5));
+  bus->flush();
+  bus->stop();
+
+  bus->start();
+  bus->publishBatch(makeTrades(5, 5));
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(sub.ids.size(), 10u);
+  EXPECT_EQ(sub.ids.back(), 9u);
+}
+
+TYPED_TEST(EventBusTest, RuntimeCapacityOverridesTemplateDefault)
+{
+  auto bus = std::make_unique<TypeParam>(EventBusConfig{.capacity = 64, .hugePages = true, .numaNode = 0});
+  EXPECT_EQ(bus->capacity(), 64u);
+
+  RecordingSubscriber sub(1);
+  bus->subscribe(&sub);
+  bus->start();
+
+  // One claim covers up to the runtime capacity; larger batches still chunk
+  const auto claim = bus->claim(64);
+  EXPECT_EQ(claim.size(), 64u);
+  for (int64_t s = claim.first; s <= claim.last; ++s)
+  {
+    bus->emplaceAt(s).trade_id = static_cast<uint64_t>(s);
+  }
+  bus->commit(claim);
+  bus->publishBatch(makeTrades(150, 64));
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(sub.ids.size(), 214u);
+  for (uint64_t i = 0; i < 214; ++i)
+  {
+    EXPECT_EQ(sub.ids[i], i);
+  }
+}
+
+TYPED_TEST(EventBusTest, RuntimeCapacityMustBeAPowerOfTwo)
+{
+  EXPECT_THROW(std::make_unique<TypeParam>(EventBusConfig{.capacity = 48}), std::invalid_argument);
+  EXPECT_THROW(std::make_unique<TypeParam>(EventBusConfig{.capacity = 1000}), std::invalid_argument);
+  EXPECT_EQ(std::make_unique<TypeParam>(EventBusConfig{.capacity = 16})->capacity(), 16u);
+}
+
+TYPED_TEST(EventBusTest, StatsReportLagStallsAndSkips)
+{
+  auto bus = std::make_unique<TypeParam>();
+  BatchingSubscriber slow;
+  RecordingSubscriber filtered(1);
+  bus->subscribe(&slow);
+  bus->subscribe(&filtered, SymbolFilter{2});
+  bus->start();
+
+  TradeEvent first;
+  first.trade_id = 0;
+  bus->publish(first);
+  while (!slow.entered.load())
+  {
+    std::this_thread::yield();
+  }
+
+  // Fill the ring, then publish two more: that publisher must stall on the slow consumer
+  bus->publishBatch(makeTrades(7, 1));
+  std::thread publisher([&]
+                        { bus->publishBatch(makeTrades(2, 8)); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+  const auto stalled = bus->stats();
+  EXPECT_EQ(stalled.capacity, 8u);
+  ASSERT_EQ(stalled.consumers.size(), 2u);
+  EXPECT_EQ(stalled.consumers[0].listener, &slow);
+  EXPECT_EQ(stalled.consumers[0].seq, -1);
+  EXPECT_GE(stalled.occupancy, 8);
+  EXPECT_GE(stalled.consumers[0].lag, 8);
+
+  slow.release.store(true);
+  publisher.join();
+  bus->flush();
+
+  const auto done = bus->stats();
+  bus->stop();
+
+  EXPECT_EQ(done.occupancy, 0);
+  EXPECT_GE(done.publishStalls, 1u);
+  EXPECT_GT(done.publishStallNs, 0u);
+  EXPECT_EQ(done.consumers[0].dispatched, 10u);
+  EXPECT_EQ(done.consumers[0].skipped, 0u);
+  EXPECT_GE(done.consumers[0].maxLag, 2);
+  EXPECT_EQ(done.consumers[1].lag, 0);
+  EXPECT_EQ(done.consumers[1].dispatched, 0u);
+  EXPECT_EQ(done.consumers[1].skipped, 10u);
+}
+
+TYPED_TEST(EventBusTest, GroupMembersShareOneThreadWithOwnFilters)
+{
+  auto bus = std::make_unique<TypeParam>();
+  ThreadRecordingSubscriber odd(1), even(2);
+  bus->subscribe(&odd, SymbolFilter{1});
+  bus->subscribe(&even, {.symbols = SymbolFilter{2}, .group = &odd});
+  EXPECT_EQ(bus->consumerCount(), 2u);
+  bus->start();
+
+  auto trades = makeTrades(20);
+  for (auto& t : trades)
+  {
+    t.trade.symbol = (t.trade_id % 2) ? 1 : 2;
+  }
+  bus->publishBatch(trades);
+  bus->flush();
+
+  const auto stats = bus->stats();
+  bus->stop();
+
+  ASSERT_EQ(stats.consumers.size(), 1u);
+  EXPECT_EQ(stats.consumers[0].members, 2u);
+  EXPECT_EQ(stats.consumers[0].dispatched, 20u);
+  EXPECT_EQ(stats.consumers[0].skipped, 20u);
+
+  ASSERT_EQ(odd.ids.size(), 10u);
+  ASSERT_EQ(even.ids.size(), 10u);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(odd.ids[i], 2 * i + 1);
+    EXPECT_EQ(even.ids[i], 2 * i);
+  }
+  ASSERT_EQ(odd.threads.size(), 1u);
+  EXPECT_EQ(odd.threads, even.threads);
+}
+
+TYPED_TEST(EventBusTest, GroupMembersJoinAndLeaveWhileRunning)
+{
+  auto bus = std::make_unique<TypeParam>();
+  ThreadRecordingSubscriber lead(1), joiner(2);
+  bus->subscribe(&lead);
+  bus->start();
+
+  bus->publishBatch(makeTrades(10));
+  bus->flush();
+
+  bus->subscribe(&joiner, {.group = &lead});
+  bus->publishBatch(makeTrades(10, 10));
+  bus->flush();
+
+  // The leader leaves; the remaining member keeps the group's thread slot and sequence
+  EXPECT_TRUE(bus->unsubscribe(&lead));
+  EXPECT_EQ(bus->consumerCount(), 1u);
+  bus->publishBatch(makeTrades(10, 20));
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(lead.ids.size(), 20u);
+  ASSERT_EQ(joiner.ids.size(), 20u);
+  for (uint64_t i = 0; i < 20; ++i)
+  {
+    EXPECT_EQ(lead.ids[i], i);
+    EXPECT_EQ(joiner.ids[i], 10 + i);
+  }
+  EXPECT_EQ(bus->stats().consumers.size(), 1u);
+}
+
+TYPED_TEST(EventBusTest, TryPublishFailsInsteadOfWaiting)
+{
+  auto bus = std::make_unique<TypeParam>();
+  BatchingSubscriber slow;
+  bus->subscribe(&slow);
+  bus->start();
+
+  TradeEvent ev;
+  ev.trade_id = 0;
+  EXPECT_EQ(bus->tryPublish(ev), 0);
+  while (!slow.entered.load())
+  {
+    std::this_thread::yield();
+  }
+
+  for (uint64_t i = 1; i < 8; ++i)
+  {
+    ev.trade_id = i;
+    EXPECT_EQ(bus->tryPublish(ev), static_cast<int64_t>(i));
+  }
+  ev.trade_id = 8;
+  EXPECT_EQ(bus->tryPublish(ev), -1);
+  EXPECT_EQ(bus->stats().rejected, 1u);
+
+  slow.release.store(true);
+  bus->flush();
+  EXPECT_EQ(bus->tryPublish(ev), 8);
+  bus->flush();
+  bus->stop();
+
+  ASSERT_EQ(slow.ids.size(), 9u);
+  for (uint64_t i = 0; i < 9; ++i)
+  {
+    EXPECT_EQ(slow.ids[i], i);
+  }
+}
+
+TYPED_TEST(EventBusTest, DropNewestDropsWhenRingIsFull)
+{
+  auto bus = std::make_unique<TypeParam>();
+  bus->setOverflowPolicy(BusOverflowPolicy::DropNewest);
+  BatchingSubscriber slow;
+  bus->subscribe(&slow);
+  bus->start();
+
+  TradeEvent first;
+  first.trade_id = 0;
+  bus->publish(first);
+  while (!slow.entered.load())
+  {
+    std::this_thread::yield();
+  }
+
+  EXPECT_EQ(bus->publishBatch(makeTrades(7, 1)), 7);
+  EXPECT_EQ(bus->publish(makeTrades(1, 8)[0]), -1);
+  EXPECT_EQ(bus->publishBatch(makeTrades(3, 9)), -1);
+
+  slow.release.store(true);
+  bus->flush();
+  const auto stats = bus->stats();
+  bus->stop();
+
+  EXPECT_EQ(stats.dropped, 4u);
+  EXPECT_EQ(stats.publishStalls, 0u);
+  EXPECT_EQ(slow.ids.size(), 8u);
+}
+
+TYPED_TEST(EventBusTest, EvictLaggingDemotesStuckConsumer)
+{
+  auto bus = std::make_unique<TypeParam>();
+  bus->setOverflowPolicy(BusOverflowPolicy::EvictLagging, std::chrono::milliseconds{20});
+  RecordingSubscriber healthy(1);
+  BatchingSubscriber stuck;
+  bus->subscribe(&healthy);
+  bus->subscribe(&stuck);
+  bus->start();
+
+  TradeEvent first;
+  first.trade_id = 0;
+  bus->publish(first);
+  while (!stuck.entered.load())
+  {
+    std::this_thread::yield();
+  }
+
+  // Several ring lengths go through although the stuck consumer never advances
+  bus->publishBatch(makeTrades(40, 1));
+  bus->flush();
+
+  const auto stats = bus->stats();
+  stuck.release.store(true);
+  bus->stop();
+
+  EXPECT_EQ(stats.evictions, 1u);
+  ASSERT_EQ(stats.consumers.size(), 2u);
+  EXPECT_FALSE(stats.consumers[0].evicted);
+  EXPECT_TRUE(stats.consumers[1].evicted);
+  EXPECT_FALSE(stats.consumers[1].required);
+  EXPECT_EQ(healthy.ids.size(), 41u);
+}
+
+TYPED_TEST(EventBusTest, EvictedConsumerResumesAfterLap)
+{
+  auto bus = std::make_unique<TypeParam>();
+  bus->setOverflowPolicy(BusOverflowPolicy::EvictLagging, std::chrono::milliseconds{20});
+  RecordingSubscriber healthy(1);
+  BatchingSubscriber stuck;
+  bus->subscribe(&healthy);
+  bus->subscribe(&stuck);
+  bus->start();
+
+  TradeEvent first;
+  first.trade_id = 0;
+  bus->publish(first);
+  while (!stuck.entered.load())
+  {
+    std::this_thread::yield();
+  }
+  bus->publishBatch(makeTrades(40, 1));
+  bus->flush();
+  ASSERT_EQ(bus->stats().evictions, 1u);
+
+  // Once unstuck it skips what was overwritten and follows the publisher again
+  stuck.release.store(true);
+  const int64_t last = bus->publishBatch(makeTrades(4, 100));
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (bus->stats().consumers[1].seq < last && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::yield();
+  }
+
+  const auto stats = bus->stats();
+  bus->stop();
+
+  EXPECT_EQ(stats.consumers[1].seq, last);
+  EXPECT_GT(stats.consumers[1].lost, 0u);
+  ASSERT_FALSE(stuck.ids.empty());
+  EXPECT_EQ(stuck.ids.back(), 103u);
+  EXPECT_EQ(stats.consumers[1].dispatched + stats.consumers[1].lost, 45u);
+}
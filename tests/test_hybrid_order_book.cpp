@@ -0,0 +1,170 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/hybrid_order_book.h"
+#include "flox/common.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+using namespace flox;
+
+namespace
+{
+
+using BookUpdatePool = pool::Pool<BookUpdateEvent, 7>;
+
+class HybridOrderBookTest : public ::testing::Test
+{
+ protected:
+  BookUpdatePool pool;
+
+  pool::Handle<BookUpdateEvent> make(BookUpdateType type, const std::vector<BookLevel>& bids,
+                                     const std::vector<BookLevel>& asks)
+  {
+    auto opt = pool.acquire();
+    assert(opt);
+    auto& u = *opt;
+    u->update.type = type;
+    u->update.bids.assign(bids.begin(), bids.end());
+    u->update.asks.assign(asks.begin(), asks.end());
+    return std::move(u);
+  }
+};
+
+BookLevel level(double px, double qty) { return {Price::fromDouble(px), Quantity::fromDouble(qty)}; }
+
+void expectPairNear(const std::pair<double, double>& got, double qty, double notional)
+{
+  EXPECT_NEAR(got.first, qty, 1e-6);
+  EXPECT_NEAR(got.second, notional, 1e-4 * std::max(1.0, std::abs(notional)));
+}
+
+}  // namespace
+
+TEST_F(HybridOrderBookTest, KeepsLevelsAcrossAWideRange)
+{
+  HybridOrderBook<64> book{Price::fromDouble(0.0001)};
+
+  // Millions of ticks between the touch and the far levels
+  auto snap = make(BookUpdateType::SNAPSHOT,
+                   {level(1.0, 5), level(0.9999, 1), level(0.0001, 1000)},
+                   {level(1.0001, 2), level(5000.0, 3)});
+  book.applyBookUpdate(*snap);
+
+  EXPECT_EQ(book.bestBid(), Price::fromDouble(1.0));
+  EXPECT_EQ(book.bestAsk(), Price::fromDouble(1.0001));
+  EXPECT_EQ(book.farLevels(), 2u);
+  EXPECT_EQ(book.bidAtPrice(Price::fromDouble(0.0001)), Quantity::fromDouble(1000));
+  EXPECT_EQ(book.askAtPrice(Price::fromDouble(5000.0)), Quantity::fromDouble(3));
+
+  expectPairNear(book.consumeAsks(4.0), 4.0, 2 * 1.0001 + 2 * 5000.0);
+  expectPairNear(book.consumeBids(10.0), 10.0, 5 * 1.0 + 1 * 0.9999 + 4 * 0.0001);
+
+  // A far update lands in the overflow tier instead of being dropped
+  auto far = make(BookUpdateType::DELTA, {}, {level(4000.0, 7)});
+  book.applyBookUpdate(*far);
+  EXPECT_EQ(book.askAtPrice(Price::fromDouble(4000.0)), Quantity::fromDouble(7));
+  EXPECT_EQ(book.farLevels(), 3u);
+
+  // Sweeping the near asks moves the touch into the overflow tier; the window follows
+  auto sweep = make(BookUpdateType::DELTA, {}, {level(1.0001, 0)});
+  book.applyBookUpdate(*sweep);
+  EXPECT_EQ(book.bestAsk(), Price::fromDouble(4000.0));
+  EXPECT_EQ(book.bestBid(), Price::fromDouble(1.0));
+  EXPECT_EQ(book.bidAtPrice(Price::fromDouble(0.9999)), Quantity::fromDouble(1));
+  EXPECT_EQ(book.askAtPrice(Price::fromDouble(5000.0)), Quantity::fromDouble(3));
+}
+
+TEST_F(HybridOrderBookTest, MatchesReferenceBookUnderRandomWalk)
+{
+  HybridOrderBook<64> book{Price::fromDouble(1.0), 16};
+  std::map<int64_t, double> bids, asks;
+  std::mt19937 rng(11);
+
+  auto snap = make(BookUpdateType::SNAPSHOT, {level(100000, 1)}, {level(100001, 1)});
+  book.applyBookUpdate(*snap);
+  bids[100000] = asks[100001] = 1;
+
+  int64_t mid = 100000;
+  for (int step = 0; step < 4000; ++step)
+  {
+    mid += static_cast<int64_t>(rng() % 9) - 4;
+    if (rng() % 50 == 0)
+    {
+      mid += static_cast<int64_t>(rng() % 401) - 200;  // jump past the window
+    }
+
+    std::vector<BookLevel> b, a;
+    auto put = [](std::map<int64_t, double>& ref, std::vector<BookLevel>& out, int64_t tick, double qty)
+    {
+      out.push_back(level(static_cast<double>(tick), qty));
+      if (qty == 0)
+      {
+        ref.erase(tick);
+      }
+      else
+      {
+        ref[tick] = qty;
+      }
+    };
+
+    for (auto it = bids.begin(); it != bids.end();)
+    {
+      const int64_t t = (it++)->first;
+      if (t >= mid)
+      {
+        put(bids, b, t, 0);
+      }
+    }
+    for (auto it = asks.begin(); it != asks.end();)
+    {
+      const int64_t t = (it++)->first;
+      if (t <= mid)
+      {
+        put(asks, a, t, 0);
+      }
+    }
+    put(bids, b, mid - 1 - static_cast<int64_t>(rng() % 10), 1 + rng() % 5);
+    put(asks, a, mid + 1 + static_cast<int64_t>(rng() % 10), 1 + rng() % 5);
+    if (rng() % 5 == 0)
+    {
+      put(bids, b, mid - 100 - static_cast<int64_t>(rng() % 1000), 1 + rng() % 5);
+      put(asks, a, mid + 100 + static_cast<int64_t>(rng() % 1000), 1 + rng() % 5);
+    }
+
+    auto delta = make(BookUpdateType::DELTA, b, a);
+    book.applyBookUpdate(*delta);
+
+    ASSERT_EQ(book.bestBid(), Price::fromDouble(static_cast<double>(bids.rbegin()->first))) << step;
+    ASSERT_EQ(book.bestAsk(), Price::fromDouble(static_cast<double>(asks.begin()->first))) << step;
+
+    if (step % 100 == 0)
+    {
+      double bidQty = 0, bidNotional = 0, askQty = 0, askNotional = 0;
+      for (const auto& [t, q] : bids)
+      {
+        ASSERT_EQ(book.bidAtPrice(Price::fromDouble(static_cast<double>(t))), Quantity::fromDouble(q));
+        bidQty += q;
+        bidNotional += q * static_cast<double>(t);
+      }
+      for (const auto& [t, q] : asks)
+      {
+        ASSERT_EQ(book.askAtPrice(Price::fromDouble(static_cast<double>(t))), Quantity::fromDouble(q));
+        askQty += q;
+        askNotional += q * static_cast<double>(t);
+      }
+      expectPairNear(book.consumeBids(1e12), bidQty, bidNotional);
+      expectPairNear(book.consumeAsks(1e12), askQty, askNotional);
+    }
+  }
+}
@@ -0,0 +1,197 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/market_by_order_book.h"
+#include "flox/common.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace flox;
+
+namespace
+{
+
+Price px(double p) { return Price::fromDouble(p); }
+Quantity qty(double q) { return Quantity::fromDouble(q); }
+
+std::vector<OrderId> queue(const MarketByOrderBook& book, Side side, Price price)
+{
+  std::vector<OrderId> ids;
+  book.forEachOrder(side, price, [&](OrderId id, Quantity) { ids.push_back(id); });
+  return ids;
+}
+
+}  // namespace
+
+TEST(MarketByOrderBookTest, AggregatesLevelsInTimePriority)
+{
+  MarketByOrderBook book{64};
+
+  EXPECT_TRUE(book.addOrder(1, Side::BUY, px(100.0), qty(1)));
+  EXPECT_TRUE(book.addOrder(2, Side::BUY, px(100.0), qty(2)));
+  EXPECT_TRUE(book.addOrder(3, Side::BUY, px(99.5), qty(4)));
+  EXPECT_TRUE(book.addOrder(4, Side::SELL, px(101.0), qty(3)));
+  EXPECT_TRUE(book.addOrder(5, Side::SELL, px(100.5), qty(1)));
+
+  EXPECT_EQ(book.bestBid(), px(100.0));
+  EXPECT_EQ(book.bestAsk(), px(100.5));
+  EXPECT_EQ(book.bidAtPrice(px(100.0)), qty(3));
+  EXPECT_EQ(book.askAtPrice(px(101.0)), qty(3));
+  EXPECT_EQ(book.bidLevels(), 2u);
+  EXPECT_EQ(book.orderCount(), 5u);
+  EXPECT_EQ(queue(book, Side::BUY, px(100.0)), (std::vector<OrderId>{1, 2}));
+
+  const auto [filled, notional] = book.consumeAsks(2.0);
+  EXPECT_DOUBLE_EQ(filled, 2.0);
+  EXPECT_DOUBLE_EQ(notional, 100.5 + 101.0);
+
+  EXPECT_TRUE(book.deleteOrder(1));
+  EXPECT_TRUE(book.deleteOrder(2));
+  EXPECT_EQ(book.bestBid(), px(99.5));
+  EXPECT_EQ(book.bidAtPrice(px(100.0)), Quantity{});
+  EXPECT_EQ(book.bidLevels(), 1u);
+}
+
+TEST(MarketByOrderBookTest, ModifyKeepsPriorityOnlyWhenReducing)
+{
+  MarketByOrderBook book{64};
+  book.addOrder(1, Side::SELL, px(10.0), qty(5));
+  book.addOrder(2, Side::SELL, px(10.0), qty(5));
+  book.addOrder(3, Side::SELL, px(10.0), qty(5));
+
+  EXPECT_TRUE(book.modifyOrder(1, px(10.0), qty(2)));
+  EXPECT_EQ(queue(book, Side::SELL, px(10.0)), (std::vector<OrderId>{1, 2, 3}));
+  EXPECT_EQ(book.askAtPrice(px(10.0)), qty(12));
+
+  EXPECT_TRUE(book.modifyOrder(1, px(10.0), qty(6)));
+  EXPECT_EQ(queue(book, Side::SELL, px(10.0)), (std::vector<OrderId>{2, 3, 1}));
+  EXPECT_EQ(book.askAtPrice(px(10.0)), qty(16));
+
+  EXPECT_TRUE(book.modifyOrder(2, px(9.0), qty(5)));
+  EXPECT_EQ(book.bestAsk(), px(9.0));
+  EXPECT_EQ(book.askAtPrice(px(10.0)), qty(11));
+  EXPECT_EQ(book.orderQuantity(2), qty(5));
+
+  EXPECT_TRUE(book.modifyOrder(2, px(9.0), Quantity{}));
+  EXPECT_EQ(book.bestAsk(), px(10.0));
+  EXPECT_FALSE(book.orderQuantity(2).has_value());
+}
+
+TEST(MarketByOrderBookTest, RejectsMessagesThatDoNotFit)
+{
+  MarketByOrderBook book{2};
+
+  EXPECT_TRUE(book.addOrder(7, Side::BUY, px(1.0), qty(1)));
+  EXPECT_FALSE(book.addOrder(7, Side::BUY, px(2.0), qty(1)));
+  EXPECT_FALSE(book.addOrder(8, Side::BUY, px(1.0), Quantity{}));
+  EXPECT_FALSE(book.modifyOrder(9, px(1.0), qty(1)));
+  EXPECT_FALSE(book.deleteOrder(9));
+
+  EXPECT_TRUE(book.addOrder(8, Side::SELL, px(2.0), qty(1)));
+  EXPECT_FALSE(book.addOrder(10, Side::SELL, px(2.0), qty(1)));
+  EXPECT_EQ(book.orderCount(), 2u);
+  EXPECT_EQ(book.bidAtPrice(px(1.0)), qty(1));
+
+  // Freed nodes are reused
+  EXPECT_TRUE(book.deleteOrder(7));
+  EXPECT_TRUE(book.addOrder(10, Side::SELL, px(2.0), qty(1)));
+  EXPECT_EQ(book.askAtPrice(px(2.0)), qty(2));
+
+  MboUpdate clear{};
+  clear.type = MboUpdateType::CLEAR;
+  EXPECT_TRUE(book.apply(clear));
+  EXPECT_EQ(book.orderCount(), 0u);
+  EXPECT_FALSE(book.bestAsk().has_value());
+  EXPECT_TRUE(book.addOrder(7, Side::BUY, px(1.0), qty(1)));
+}
+
+TEST(MarketByOrderBookTest, MatchesReferenceUnderChurn)
+{
+  struct Ref
+  {
+    Side side;
+    int64_t tick;
+    int64_t qty;
+  };
+
+  MarketByOrderBook book{4096, 16};
+  std::map<OrderId, Ref> orders;
+  std::mt19937_64 rng(7);
+  OrderId nextId = 1;
+
+  for (int step = 0; step < 50000; ++step)
+  {
+    MboUpdate up{};
+    const auto roll = rng() % 10;
+    if (orders.size() < 64 || roll < 4)
+    {
+      const Side side = rng() % 2 ? Side::BUY : Side::SELL;
+      const int64_t tick = side == Side::BUY ? 1000 - rng() % 40 : 1001 + rng() % 40;
+      up.type = MboUpdateType::ADD;
+      up.orderId = nextId++ * 0x10001;  // ids sharing low bits stress the index
+      up.side = side;
+      up.price = Price::fromRaw(tick * 10'000);
+      up.quantity = Quantity::fromRaw(static_cast<int64_t>(1 + rng() % 100));
+      orders[up.orderId] = {side, tick, up.quantity.raw()};
+    }
+    else
+    {
+      auto it = orders.begin();
+      std::advance(it, rng() % orders.size());
+      up.orderId = it->first;
+      if (roll < 8)
+      {
+        up.type = MboUpdateType::DELETE;
+        orders.erase(it);
+      }
+      else
+      {
+        up.type = MboUpdateType::MODIFY;
+        it->second.tick += (rng() % 3 == 0) ? 1 : 0;
+        it->second.qty = static_cast<int64_t>(1 + rng() % 100);
+        up.price = Price::fromRaw(it->second.tick * 10'000);
+        up.quantity = Quantity::fromRaw(it->second.qty);
+      }
+    }
+    ASSERT_TRUE(book.apply(up)) << step;
+    ASSERT_EQ(book.orderCount(), orders.size());
+
+    if (step % 1000 == 0)
+    {
+      std::map<int64_t, int64_t> bids, asks;
+      for (const auto& [id, o] : orders)
+      {
+        ASSERT_EQ(book.orderQuantity(id), Quantity::fromRaw(o.qty));
+        (o.side == Side::BUY ? bids : asks)[o.tick] += o.qty;
+      }
+      ASSERT_EQ(book.bidLevels(), bids.size());
+      ASSERT_EQ(book.askLevels(), asks.size());
+      for (const auto& [tick, q] : bids)
+      {
+        ASSERT_EQ(book.bidAtPrice(Price::fromRaw(tick * 10'000)), Quantity::fromRaw(q));
+      }
+      for (const auto& [tick, q] : asks)
+      {
+        ASSERT_EQ(book.askAtPrice(Price::fromRaw(tick * 10'000)), Quantity::fromRaw(q));
+      }
+      if (!bids.empty())
+      {
+        ASSERT_EQ(book.bestBid(), Price::fromRaw(bids.rbegin()->first * 10'000));
+      }
+      if (!asks.empty())
+      {
+        ASSERT_EQ(book.bestAsk(), Price::fromRaw(asks.begin()->first * 10'000));
+      }
+    }
+  }
+}
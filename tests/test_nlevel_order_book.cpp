@@ -13,6 +13,12 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+
 using namespace flox;
 
 class NLevelOrderBookTest : public ::testing::Test
@@ -190,3 +196,583 @@ TEST_F(NLevelOrderBookTest, Consume_IsConstDoesNotMutate)
   EXPECT_EQ(book.bestAsk(), Price::fromDouble(100.1));
   EXPECT_EQ(book.bestBid(), Price::fromDouble(100.0));
 }
+
+TEST_F(NLevelOrderBookTest, BestLevelsFollowSweepsAcrossEmptyRanges)
+{
+  auto snap = makeSnapshot({{Price::fromDouble(100.0), Quantity::fromDouble(1.0)},
+                            {Price::fromDouble(60.0), Quantity::fromDouble(2.0)}},
+                           {{Price::fromDouble(100.1), Quantity::fromDouble(1.0)},
+                            {Price::fromDouble(140.0), Quantity::fromDouble(4.0)}});
+  book.applyBookUpdate(*snap);
+
+  auto sweep = makeDelta({{Price::fromDouble(100.0), Quantity::fromDouble(0.0)}},
+                         {{Price::fromDouble(100.1), Quantity::fromDouble(0.0)}});
+  book.applyBookUpdate(*sweep);
+
+  EXPECT_EQ(book.bestBid(), Price::fromDouble(60.0));
+  EXPECT_EQ(book.bestAsk(), Price::fromDouble(140.0));
+  ExpectPairNear(book.consumeAsks(10.0), 4.0, 560.0);
+  ExpectPairNear(book.consumeBids(10.0), 2.0, 120.0);
+
+  std::ostringstream os;
+  book.dump(os, 5);
+  EXPECT_NE(os.str().find("140.0000"), std::string::npos);
+  EXPECT_NE(os.str().find("60.0000"), std::string::npos);
+
+  auto rest = makeDelta({{Price::fromDouble(60.0), Quantity::fromDouble(0.0)}},
+                        {{Price::fromDouble(140.0), Quantity::fromDouble(0.0)}});
+  book.applyBookUpdate(*rest);
+  EXPECT_FALSE(book.bestBid().has_value());
+  EXPECT_FALSE(book.bestAsk().has_value());
+
+  auto resnap = makeSnapshot({{Price::fromDouble(99.0), Quantity::fromDouble(1.0)}}, {});
+  book.applyBookUpdate(*resnap);
+  EXPECT_EQ(book.bestBid(), Price::fromDouble(99.0));
+  EXPECT_EQ(book.bidAtPrice(Price::fromDouble(60.0)), Quantity{});
+}
+
+TEST_F(NLevelOrderBookTest, WindowSlidesWithTrendingDeltas)
+{
+  NLevelOrderBook<128> small{Price::fromDouble(1.0)};
+  std::map<int64_t, double> bids, asks;
+  std::mt19937 rng(7);
+
+  auto snap = makeSnapshot({{Price::fromDouble(1000), Quantity::fromDouble(1)}},
+                           {{Price::fromDouble(1001), Quantity::fromDouble(1)}});
+  small.applyBookUpdate(*snap);
+  bids[1000] = asks[1001] = 1;
+
+  int64_t mid = 1000;
+  for (int step = 0; step < 3000; ++step)
+  {
+    mid += (step / 500) % 2 == 0 ? 1 : -1;
+    if (rng() % 4 == 0)
+    {
+      mid += static_cast<int64_t>(rng() % 7) - 3;
+    }
+
+    std::vector<BookLevel> b, a;
+    auto put = [](std::map<int64_t, double>& ref, std::vector<BookLevel>& out, int64_t tick, double qty)
+    {
+      out.emplace_back(Price::fromDouble(static_cast<double>(tick)), Quantity::fromDouble(qty));
+      if (qty == 0)
+      {
+        ref.erase(tick);
+      }
+      else
+      {
+        ref[tick] = qty;
+      }
+    };
+
+    // Crossed and distant levels are removed, a few new ones added near the mid
+    for (auto it = bids.begin(); it != bids.end();)
+    {
+      const int64_t t = (it++)->first;
+      if (t >= mid || t < mid - 40)
+      {
+        put(bids, b, t, 0);
+      }
+    }
+    for (auto it = asks.begin(); it != asks.end();)
+    {
+      const int64_t t = (it++)->first;
+      if (t <= mid || t > mid + 40)
+      {
+        put(asks, a, t, 0);
+      }
+    }
+    put(bids, b, mid - 1 - static_cast<int64_t>(rng() % 20), 1 + rng() % 5);
+    put(asks, a, mid + 1 + static_cast<int64_t>(rng() % 20), 1 + rng() % 5);
+
+    auto delta = makeDelta(b, a);
+    small.applyBookUpdate(*delta);
+
+    ASSERT_EQ(small.bestBid(), Price::fromDouble(static_cast<double>(bids.rbegin()->first))) << step;
+    ASSERT_EQ(small.bestAsk(), Price::fromDouble(static_cast<double>(asks.begin()->first))) << step;
+    for (const auto& [t, q] : bids)
+    {
+      ASSERT_EQ(small.bidAtPrice(Price::fromDouble(static_cast<double>(t))), Quantity::fromDouble(q)) << step;
+    }
+    for (const auto& [t, q] : asks)
+    {
+      ASSERT_EQ(small.askAtPrice(Price::fromDouble(static_cast<double>(t))), Quantity::fromDouble(q)) << step;
+    }
+
+    double askQty = 0, askNotional = 0;
+    for (const auto& [t, q] : asks)
+    {
+      askQty += q;
+      askNotional += q * static_cast<double>(t);
+    }
+    ExpectPairNear(small.consumeAsks(1e9), askQty, askNotional);
+  }
+}
+
+TEST_F(NLevelOrderBookTest, DistantDeltaDoesNotEvictTopOfBook)
+{
+  NLevelOrderBook<128> small{Price::fromDouble(1.0)};
+  auto snap = makeSnapshot({{Price::fromDouble(1000), Quantity::fromDouble(1)}},
+                           {{Price::fromDouble(1001), Quantity::fromDouble(1)}});
+  small.applyBookUpdate(*snap);
+
+  // Too far from the top of book to fit in one window: dropped, book unchanged
+  auto far = makeDelta({}, {{Price::fromDouble(1500), Quantity::fromDouble(3)}});
+  small.applyBookUpdate(*far);
+  EXPECT_EQ(small.askAtPrice(Price::fromDouble(1500)), Quantity{});
+  EXPECT_EQ(small.bestBid(), Price::fromDouble(1000));
+  EXPECT_EQ(small.bestAsk(), Price::fromDouble(1001));
+
+  // Within reach: the window slides up and keeps both best levels
+  auto near = makeDelta({}, {{Price::fromDouble(1100), Quantity::fromDouble(2)}});
+  small.applyBookUpdate(*near);
+  EXPECT_EQ(small.askAtPrice(Price::fromDouble(1100)), Quantity::fromDouble(2));
+  EXPECT_EQ(small.bestBid(), Price::fromDouble(1000));
+  EXPECT_EQ(small.bestAsk(), Price::fromDouble(1001));
+  ExpectPairNear(small.consumeAsks(3.0), 3.0, 1001.0 + 2 * 1100.0);
+}
+
+TEST_F(NLevelOrderBookTest, FillIsExactInFixedPoint)
+{
+  auto snap = makeSnapshot({{Price::fromDouble(100.0), Quantity::fromDouble(1.0)},
+                            {Price::fromDouble(99.7), Quantity::fromDouble(0.3)},
+                            {Price::fromDouble(99.0), Quantity::fromDouble(5.0)}},
+                           {{Price::fromDouble(101.0), Quantity::fromDouble(1.5)},
+                            {Price::fromDouble(101.3), Quantity::fromDouble(2.0)},
+                            {Price::fromDouble(102.0), Quantity::fromDouble(3.0)}});
+  book.applyBookUpdate(*snap);
+
+  const DepthFill asks = book.fillAsks(Quantity::fromDouble(4.0));
+  EXPECT_EQ(asks.filled, Quantity::fromDouble(4.0));
+  EXPECT_EQ(asks.notional, Volume::fromDouble(1.5 * 101.0 + 2.0 * 101.3 + 0.5 * 102.0));
+  EXPECT_EQ(asks.vwap, Price::fromDouble(101.275));
+  EXPECT_EQ(asks.worst, Price::fromDouble(102.0));
+
+  const DepthFill bids = book.fillBids(Quantity::fromDouble(10.0));
+  EXPECT_EQ(bids.filled, Quantity::fromDouble(6.3));
+  EXPECT_EQ(bids.notional, Volume::fromDouble(100.0 + 0.3 * 99.7 + 5.0 * 99.0));
+  EXPECT_EQ(bids.worst, Price::fromDouble(99.0));
+
+  EXPECT_EQ(book.askDepthWithinBps(30), Quantity::fromDouble(3.5));  // up to 101.303
+  EXPECT_EQ(book.bidDepthWithinBps(30), Quantity::fromDouble(1.3));  // down to 99.7
+
+  std::array<Quantity, 4> cum{};
+  ASSERT_EQ(book.cumulativeAskDepth(cum), 4u);
+  EXPECT_EQ(cum[0], Quantity::fromDouble(1.5));
+  EXPECT_EQ(cum[2], Quantity::fromDouble(1.5));
+  EXPECT_EQ(cum[3], Quantity::fromDouble(3.5));
+  ASSERT_EQ(book.cumulativeBidDepth(cum), 4u);
+  EXPECT_EQ(cum[2], Quantity::fromDouble(1.0));
+  EXPECT_EQ(cum[3], Quantity::fromDouble(1.3));
+
+  const DepthFill top = book.topBids(2);
+  EXPECT_EQ(top.filled, Quantity::fromDouble(1.3));
+  EXPECT_EQ(top.worst, Price::fromDouble(99.7));
+
+  EXPECT_EQ(NLevelOrderBook<>{Price::fromDouble(0.1)}.fillAsks(Quantity::fromDouble(1.0)).filled, Quantity{});
+}
+
+TEST_F(NLevelOrderBookTest, DepthKernelsMatchReferenceAcrossRingWrap)
+{
+  using i128 = __int128_t;
+  constexpr int64_t Tick = 100'000;  // 0.1 in raw price units
+
+  NLevelOrderBook<256> small{Price::fromRaw(Tick)};
+  std::map<int64_t, int64_t> bids, asks;  // tick -> raw quantity
+  std::mt19937_64 rng(5);
+
+  auto expectFill = [&](const DepthFill& got, const auto& levels, int64_t need)
+  {
+    int64_t filled = 0, last = 0;
+    i128 tickQty = 0;
+    for (const auto& [t, q] : levels)
+    {
+      if (filled == need)
+      {
+        break;
+      }
+      const int64_t take = std::min(q, need - filled);
+      filled += take;
+      tickQty += static_cast<i128>(t) * take;
+      last = t;
+    }
+    ASSERT_EQ(got.filled.raw(), filled);
+    if (filled > 0)
+    {
+      ASSERT_EQ(got.notional.raw(), static_cast<int64_t>(tickQty * Tick / Quantity::Scale));
+      ASSERT_EQ(got.vwap.raw(), static_cast<int64_t>(tickQty * Tick / filled));
+      ASSERT_EQ(got.worst.raw(), last * Tick);
+    }
+  };
+
+  int64_t mid = 100'000;
+  for (int step = 0; step < 300; ++step)
+  {
+    mid += static_cast<int64_t>(rng() % 7);  // trends up, so the window keeps sliding
+
+    std::vector<BookLevel> b, a;
+    auto put = [](std::map<int64_t, int64_t>& ref, std::vector<BookLevel>& out, int64_t t, int64_t q)
+    {
+      out.push_back({Price::fromRaw(t * Tick), Quantity::fromRaw(q)});
+      q ? void(ref[t] = q) : void(ref.erase(t));
+    };
+    for (auto it = bids.begin(); it != bids.end();)
+    {
+      const int64_t t = (it++)->first;
+      if (t >= mid || t < mid - 100)
+      {
+        put(bids, b, t, 0);
+      }
+    }
+    for (auto it = asks.begin(); it != asks.end();)
+    {
+      const int64_t t = (it++)->first;
+      if (t <= mid || t > mid + 100)
+      {
+        put(asks, a, t, 0);
+      }
+    }
+    for (int k = 0; k < 20; ++k)
+    {
+      put(bids, b, mid - 1 - static_cast<int64_t>(rng() % 100), 1 + static_cast<int64_t>(rng() % 5'000'000));
+      put(asks, a, mid + 1 + static_cast<int64_t>(rng() % 100), 1 + static_cast<int64_t>(rng() % 5'000'000));
+    }
+    auto delta = makeDelta(b, a);
+    small.applyBookUpdate(*delta);
+
+    const std::map<int64_t, int64_t, std::greater<>> bidsDesc(bids.begin(), bids.end());
+    for (const int64_t need : {int64_t{1}, int64_t{3'000'000}, int64_t{40'000'000}, int64_t{1'000'000'000'000}})
+    {
+      expectFill(small.fillAsks(Quantity::fromRaw(need)), asks, need);
+      expectFill(small.fillBids(Quantity::fromRaw(need)), bidsDesc, need);
+    }
+
+    const int64_t bestAsk = asks.begin()->first, bestBid = bids.rbegin()->first;
+    const uint32_t bps = static_cast<uint32_t>(rng() % 8);  // up to 80 ticks at this price
+    int64_t within = 0;
+    for (const auto& [t, q] : asks)
+    {
+      within += t <= bestAsk + bestAsk * bps / 10'000 ? q : 0;
+    }
+    ASSERT_EQ(small.askDepthWithinBps(bps).raw(), within);
+    within = 0;
+    for (const auto& [t, q] : bids)
+    {
+      within += t >= bestBid - bestBid * bps / 10'000 ? q : 0;
+    }
+    ASSERT_EQ(small.bidDepthWithinBps(bps).raw(), within);
+
+    std::array<Quantity, 120> cum{};
+    const size_t n = small.cumulativeAskDepth(cum);
+    int64_t run = 0;
+    for (size_t k = 0; k < n; ++k)
+    {
+      const auto it = asks.find(bestAsk + static_cast<int64_t>(k));
+      run += it != asks.end() ? it->second : 0;
+      ASSERT_EQ(cum[k].raw(), run) << k;
+    }
+    run = 0;
+    const size_t m = small.cumulativeBidDepth(cum);
+    for (size_t k = 0; k < m; ++k)
+    {
+      const auto it = bids.find(bestBid - static_cast<int64_t>(k));
+      run += it != bids.end() ? it->second : 0;
+      ASSERT_EQ(cum[k].raw(), run) << k;
+    }
+
+    // Top-N spans partial blocks, whole blocks and more levels than the book holds
+    for (const size_t levels : {size_t{1}, size_t{5}, size_t{19}, size_t{70}, size_t{500}})
+    {
+      auto firstN = [levels](const auto& side)
+      {
+        int64_t need = 0;
+        size_t k = 0;
+        for (auto it = side.begin(); it != side.end() && k < levels; ++it, ++k)
+        {
+          need += it->second;
+        }
+        return need;
+      };
+      expectFill(small.topAsks(levels), asks, firstN(asks));
+      expectFill(small.topBids(levels), bidsDesc, firstN(bidsDesc));
+    }
+  }
+}
+
+TEST_F(NLevelOrderBookTest, DepthKernelsStayExactForHugeLevels)
+{
+  using i128 = __int128_t;
+  constexpr int64_t Tick = 10;  // cheap enough that the notional of these sizes fits
+
+  // 80 contiguous levels a side of about 2^53 raw units: a 64-level block sums fine in
+  // int64 but its index-weighted sum does not
+  NLevelOrderBook<256> small{Price::fromRaw(Tick)};
+  std::map<int64_t, int64_t> bids, asks;  // tick -> raw quantity
+  std::vector<BookLevel> b, a;
+  for (int64_t k = 0; k < 80; ++k)
+  {
+    const int64_t q = (int64_t{1} << 53) + k * 1'000'003;
+    bids[979 - k] = q;
+    asks[1'000 + k] = q;
+    b.push_back({Price::fromRaw((979 - k) * Tick), Quantity::fromRaw(q)});
+    a.push_back({Price::fromRaw((1'000 + k) * Tick), Quantity::fromRaw(q)});
+  }
+  auto snap = makeSnapshot(b, a);
+  small.applyBookUpdate(*snap);
+
+  auto expectFill = [&](const DepthFill& got, const auto& levels, int64_t need)
+  {
+    int64_t filled = 0, last = 0;
+    i128 tickQty = 0;
+    for (const auto& [t, q] : levels)
+    {
+      if (filled == need)
+      {
+        break;
+      }
+      const int64_t take = std::min(q, need - filled);
+      filled += take;
+      tickQty += static_cast<i128>(t) * take;
+      last = t;
+    }
+    ASSERT_EQ(got.filled.raw(), filled);
+    ASSERT_EQ(got.notional.raw(), static_cast<int64_t>(tickQty * Tick / Quantity::Scale));
+    ASSERT_EQ(got.vwap.raw(), static_cast<int64_t>(tickQty * Tick / filled));
+    ASSERT_EQ(got.worst.raw(), last * Tick);
+  };
+
+  const std::map<int64_t, int64_t, std::greater<>> bidsDesc(bids.begin(), bids.end());
+  for (const int64_t levels : {1, 63, 64, 70, 80})
+  {
+    const int64_t need = levels * (int64_t{1} << 53);
+    expectFill(small.fillAsks(Quantity::fromRaw(need)), asks, need);
+    expectFill(small.fillBids(Quantity::fromRaw(need)), bidsDesc, need);
+    int64_t firstN = 0;
+    for (int64_t k = 0; k < levels; ++k)
+    {
+      firstN += asks.at(1'000 + k);
+    }
+    expectFill(small.topAsks(static_cast<size_t>(levels)), asks, firstN);
+    expectFill(small.topBids(static_cast<size_t>(levels)), bidsDesc, firstN);
+  }
+}
+
+TEST_F(NLevelOrderBookTest, TouchAndTopLevelAnalytics)
+{
+  NLevelOrderBook<8192, 2> top{Price::fromDouble(0.1)};
+
+  EXPECT_FALSE(top.microprice().has_value());
+  EXPECT_FALSE(top.spreadBps().has_value());
+  EXPECT_EQ(top.queueImbalance(), 0.0);
+
+  auto snap = makeSnapshot({{Price::fromDouble(100.0), Quantity::fromDouble(3)},
+                            {Price::fromDouble(99.9), Quantity::fromDouble(1)},
+                            {Price::fromDouble(99.0), Quantity::fromDouble(50)}},
+                           {{Price::fromDouble(100.1), Quantity::fromDouble(1)},
+                            {Price::fromDouble(100.3), Quantity::fromDouble(4)}});
+  top.applyBookUpdate(*snap);
+
+  // (100.0 * 1 + 100.1 * 3) / 4
+  EXPECT_EQ(top.microprice(), Price::fromDouble(100.075));
+  EXPECT_DOUBLE_EQ(top.queueImbalance(), 0.5);
+  EXPECT_NEAR(*top.spreadBps(), 2e4 * 0.1 / 200.1, 1e-9);
+
+  EXPECT_EQ(top.topBidVolume(), Quantity::fromDouble(4));
+  EXPECT_EQ(top.topAskVolume(), Quantity::fromDouble(5));
+  EXPECT_DOUBLE_EQ(top.topImbalance(), -1.0 / 9);
+  // Bid VWAP 99.975 weighted by 5, ask VWAP 100.26 weighted by 4
+  EXPECT_EQ(top.depthWeightedMid(), Price::fromRaw((99'975'000 * 5 + 100'260'000 * 4) / 9));
+
+  // Removing the second bid level pulls the 99.0 level into the top two
+  auto delta = makeDelta({{Price::fromDouble(99.9), Quantity{}}}, {});
+  top.applyBookUpdate(*delta);
+  EXPECT_EQ(top.topBidVolume(), Quantity::fromDouble(53));
+
+  // A new best bid pushes it back out
+  delta = makeDelta({{Price::fromDouble(100.05), Quantity::fromDouble(2)}}, {});
+  top.applyBookUpdate(*delta);
+  EXPECT_EQ(top.topBidVolume(), Quantity::fromDouble(5));
+}
+
+TEST_F(NLevelOrderBookTest, IncrementalAnalyticsMatchRecomputation)
+{
+  using i128 = __int128_t;
+  constexpr int64_t Tick = 100'000;
+  constexpr size_t Top = 5;
+
+  NLevelOrderBook<256, Top> small{Price::fromRaw(Tick)};
+  std::map<int64_t, int64_t> bids, asks;  // tick -> raw quantity
+  std::mt19937_64 rng(11);
+
+  auto sums = [](auto first, auto last, int64_t& qty, i128& tickQty)
+  {
+    qty = 0;
+    tickQty = 0;
+    for (size_t k = 0; k < Top && first != last; ++k, ++first)
+    {
+      qty += first->second;
+      tickQty += static_cast<i128>(first->first) * first->second;
+    }
+  };
+
+  int64_t mid = 100'000;
+  for (int step = 0; step < 2000; ++step)
+  {
+    // Drifts both ways far enough for the window to slide and wrap
+    mid += static_cast<int64_t>(rng() % 5) - ((step / 400) % 2 == 0 ? 1 : 3);
+
+    std::vector<BookLevel> b, a;
+    auto put = [](std::map<int64_t, int64_t>& ref, std::vector<BookLevel>& out, int64_t t, int64_t q)
+    {
+      out.push_back({Price::fromRaw(t * Tick), Quantity::fromRaw(q)});
+      q ? void(ref[t] = q) : void(ref.erase(t));
+    };
+    for (auto it = bids.begin(); it != bids.end();)
+    {
+      const int64_t t = (it++)->first;
+      if (t >= mid || t < mid - 60 || rng() % 8 == 0)
+      {
+        put(bids, b, t, 0);
+      }
+    }
+    for (auto it = asks.begin(); it != asks.end();)
+    {
+      const int64_t t = (it++)->first;
+      if (t <= mid || t > mid + 60 || rng() % 8 == 0)
+      {
+        put(asks, a, t, 0);
+      }
+    }
+    for (int k = 0; k < 4; ++k)
+    {
+      put(bids, b, mid - 1 - static_cast<int64_t>(rng() % 12), 1 + static_cast<int64_t>(rng() % 5'000'000));
+      put(asks, a, mid + 1 + static_cast<int64_t>(rng() % 12), 1 + static_cast<int64_t>(rng() % 5'000'000));
+    }
+
+    if (step % 250 == 0)
+    {
+      std::vector<BookLevel> sb, sa;
+      for (const auto& [t, q] : bids)
+      {
+        sb.push_back({Price::fromRaw(t * Tick), Quantity::fromRaw(q)});
+      }
+      for (const auto& [t, q] : asks)
+      {
+        sa.push_back({Price::fromRaw(t * Tick), Quantity::fromRaw(q)});
+      }
+      small.applyBookUpdate(*makeSnapshot(sb, sa));
+    }
+    else
+    {
+      small.applyBookUpdate(*makeDelta(b, a));
+    }
+
+    int64_t bidQty, askQty;
+    i128 bidTickQty, askTickQty;
+    sums(bids.rbegin(), bids.rend(), bidQty, bidTickQty);
+    sums(asks.begin(), asks.end(), askQty, askTickQty);
+    ASSERT_EQ(small.topBidVolume().raw(), bidQty) << step;
+    ASSERT_EQ(small.topAskVolume().raw(), askQty) << step;
+    ASSERT_DOUBLE_EQ(small.topImbalance(), double(bidQty - askQty) / double(bidQty + askQty)) << step;
+
+    const i128 bidVwap = bidTickQty * Tick / bidQty, askVwap = askTickQty * Tick / askQty;
+    ASSERT_EQ(small.depthWeightedMid()->raw(),
+              static_cast<int64_t>((bidVwap * askQty + askVwap * bidQty) / (bidQty + askQty)))
+        << step;
+
+    const auto [bidTick, bidTouch] = *bids.rbegin();
+    const auto [askTick, askTouch] = *asks.begin();
+    ASSERT_EQ(small.microprice()->raw(),
+              static_cast<int64_t>((static_cast<i128>(bidTick) * askTouch + static_cast<i128>(askTick) * bidTouch) *
+                                   Tick / (bidTouch + askTouch)))
+        << step;
+    ASSERT_DOUBLE_EQ(small.queueImbalance(), double(bidTouch - askTouch) / double(bidTouch + askTouch)) << step;
+  }
+}
+
+TEST_F(NLevelOrderBookTest, SnapshotDiffMatchesFullRebuild)
+{
+  constexpr int64_t Tick = 100'000;
+  NLevelOrderBook<256, 3> full{Price::fromRaw(Tick)}, diffed{Price::fromRaw(Tick)}, replayed{Price::fromRaw(Tick)};
+  std::mt19937_64 rng(3);
+
+  auto levels = [](const auto& book)
+  {
+    std::vector<BookLevel> b(256), a(256);
+    b.resize(book.bidDepth(b));
+    a.resize(book.askDepth(a));
+    std::vector<std::pair<int64_t, int64_t>> out;
+    for (const auto& l : b)
+    {
+      out.emplace_back(-l.price.raw(), l.quantity.raw());
+    }
+    for (const auto& l : a)
+    {
+      out.emplace_back(l.price.raw(), l.quantity.raw());
+    }
+    return out;
+  };
+
+  std::map<int64_t, int64_t> bids, asks;
+  int64_t mid = 100'000;
+  for (int step = 0; step < 500; ++step)
+  {
+    // Mostly small moves and requotes; now and then a jump past the window
+    mid += step % 97 == 0 ? 1000 : static_cast<int64_t>(rng() % 5) - 2;
+    for (auto* side : {&bids, &asks})
+    {
+      for (auto it = side->begin(); it != side->end();)
+      {
+        const bool stale = side == &bids ? (it->first >= mid || it->first < mid - 50)
+                                         : (it->first <= mid || it->first > mid + 50);
+        it = stale || rng() % 10 == 0 ? side->erase(it) : std::next(it);
+      }
+    }
+    for (int k = 0; k < 6; ++k)
+    {
+      bids[mid - 1 - static_cast<int64_t>(rng() % 50)] = 1 + static_cast<int64_t>(rng() % 1'000'000);
+      asks[mid + 1 + static_cast<int64_t>(rng() % 50)] = 1 + static_cast<int64_t>(rng() % 1'000'000);
+    }
+
+    std::vector<BookLevel> sb, sa;
+    for (const auto& [t, q] : bids)
+    {
+      sb.push_back({Price::fromRaw(t * Tick), Quantity::fromRaw(q)});
+    }
+    for (const auto& [t, q] : asks)
+    {
+      sa.push_back({Price::fromRaw(t * Tick), Quantity::fromRaw(q)});
+    }
+    auto snap = makeSnapshot(sb, sa);
+    full.applyBookUpdate(*snap);
+
+    std::vector<BookLevel> db, da;
+    const bool stays = diffed.applySnapshotDiff(snap->update, [&](Side side, Price p, Quantity q)
+                                                { (side == Side::BUY ? db : da).push_back({p, q}); });
+    EXPECT_EQ(stays, step % 97 != 0) << step;
+    if (!stays)
+    {
+      replayed.applyBookUpdate(*snap);
+    }
+    else
+    {
+      replayed.applyBookUpdate(*makeDelta(db, da));
+    }
+
+    const auto expected = levels(full);
+    ASSERT_EQ(levels(diffed), expected) << step;
+    ASSERT_EQ(levels(replayed), expected) << step;
+    ASSERT_EQ(diffed.bestBid(), full.bestBid()) << step;
+    ASSERT_EQ(diffed.bestAsk(), full.bestAsk()) << step;
+    ASSERT_EQ(diffed.topBidVolume(), full.topBidVolume()) << step;
+    ASSERT_EQ(diffed.topAskVolume(), full.topAskVolume()) << step;
+  }
+
+  // An identical snapshot changes nothing
+  std::vector<BookLevel> b(256), a(256);
+  b.resize(full.bidDepth(b));
+  a.resize(full.askDepth(a));
+  size_t changes = 0;
+  diffed.applySnapshotDiff(makeSnapshot(b, a)->update, [&](Side, Price, Quantity) { ++changes; });
+  EXPECT_EQ(changes, 0u);
+}
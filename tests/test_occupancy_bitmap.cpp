@@ -0,0 +1,117 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/util/base/occupancy_bitmap.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace flox;
+
+namespace
+{
+
+template <size_t N>
+void checkAgainstReference(size_t ops, uint32_t seed)
+{
+  OccupancyBitmap<N> bits;
+  std::vector<bool> ref(N, false);
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> idx(0, N - 1);
+
+  auto refNext = [&](size_t from)
+  {
+    for (size_t i = from; i < N; ++i)
+    {
+      if (ref[i])
+      {
+        return i;
+      }
+    }
+    return N;
+  };
+  auto refPrev = [&](size_t from)
+  {
+    for (size_t i = std::min(from, N - 1) + 1; i-- > 0;)
+    {
+      if (ref[i])
+      {
+        return i;
+      }
+    }
+    return N;
+  };
+
+  for (size_t op = 0; op < ops; ++op)
+  {
+    const size_t i = idx(rng);
+    if (rng() % 3 == 0)
+    {
+      bits.reset(i);
+      ref[i] = false;
+    }
+    else
+    {
+      bits.set(i);
+      ref[i] = true;
+    }
+
+    const size_t probe = idx(rng);
+    ASSERT_EQ(bits.test(probe), ref[probe]);
+    ASSERT_EQ(bits.next(probe), refNext(probe));
+    ASSERT_EQ(bits.prev(probe), refPrev(probe));
+  }
+  EXPECT_EQ(bits.count(), static_cast<size_t>(std::count(ref.begin(), ref.end(), true)));
+}
+
+}  // namespace
+
+TEST(OccupancyBitmapTest, EmptyBitmapHasNoNeighbours)
+{
+  OccupancyBitmap<8192> bits;
+  EXPECT_FALSE(bits.any());
+  EXPECT_EQ(bits.next(0), bits.NPOS);
+  EXPECT_EQ(bits.prev(8191), bits.NPOS);
+  EXPECT_EQ(bits.next(9000), bits.NPOS);
+}
+
+TEST(OccupancyBitmapTest, FindsNeighboursAcrossEmptyWords)
+{
+  OccupancyBitmap<100000> bits;
+  bits.set(3);
+  bits.set(99999);
+  bits.set(50000);
+
+  EXPECT_EQ(bits.next(4), 50000u);
+  EXPECT_EQ(bits.next(50001), 99999u);
+  EXPECT_EQ(bits.prev(49999), 3u);
+  EXPECT_EQ(bits.prev(200000), 99999u);
+
+  bits.reset(50000);
+  EXPECT_EQ(bits.next(4), 99999u);
+  EXPECT_EQ(bits.prev(99998), 3u);
+
+  std::vector<size_t> seen;
+  bits.forEach(0, 99999, [&](size_t i)
+               { seen.push_back(i); });
+  EXPECT_EQ(seen, (std::vector<size_t>{3, 99999}));
+
+  bits.clear();
+  EXPECT_FALSE(bits.any());
+}
+
+TEST(OccupancyBitmapTest, MatchesReferenceOnRandomOperations)
+{
+  checkAgainstReference<70>(5000, 1);
+  checkAgainstReference<4096>(5000, 2);
+  checkAgainstReference<100000>(5000, 3);
+}
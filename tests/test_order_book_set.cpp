@@ -0,0 +1,110 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/bus/book_update_bus.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/order_book_set.h"
+
+#include "book_update_helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace flox;
+using namespace flox::test;
+
+namespace
+{
+
+constexpr MemoryPlacement NoHugePages{};
+
+}  // namespace
+
+TEST(OrderBookSetTest, RoutesUpdatesBySymbol)
+{
+  BookUpdatePool pool;
+  OrderBookSet<> books{1, 16, NoHugePages};
+
+  ASSERT_NE(books.addSymbol(3, Price::fromDouble(0.1)), nullptr);
+  ASSERT_NE(books.addSymbol(5, Price::fromDouble(0.5)), nullptr);
+  EXPECT_EQ(books.addSymbol(16, Price::fromDouble(0.1)), nullptr);
+  EXPECT_EQ(books.size(), 2u);
+  EXPECT_EQ(books.find(4), nullptr);
+  EXPECT_EQ(books.find(1000), nullptr);
+
+  books.onBookUpdate(*make(pool, 3, BookUpdateType::SNAPSHOT, 1, {level(100.0, 1)}, {level(100.1, 2)}));
+  books.onBookUpdate(*make(pool, 5, BookUpdateType::SNAPSHOT, 1, {level(50.0, 3)}, {level(50.5, 4)}));
+  books.onBookUpdate(*make(pool, 4, BookUpdateType::SNAPSHOT, 1, {level(1.0, 1)}, {}));
+
+  EXPECT_EQ(books.find(3)->bestBid(), Price::fromDouble(100.0));
+  EXPECT_EQ(books.find(3)->bestAsk(), Price::fromDouble(100.1));
+  EXPECT_EQ(books.find(5)->bestBid(), Price::fromDouble(50.0));
+  EXPECT_EQ(books.find(5)->bestAsk(), Price::fromDouble(50.5));
+  EXPECT_EQ(books.find(5)->tickSize(), Price::fromDouble(0.5));
+
+  // Re-adding a symbol starts it over with the new tick size
+  books.addSymbol(3, Price::fromDouble(0.01));
+  EXPECT_EQ(books.size(), 2u);
+  EXPECT_EQ(books.find(3)->tickSize(), Price::fromDouble(0.01));
+  EXPECT_FALSE(books.find(3)->bestBid().has_value());
+}
+
+TEST(OrderBookSetTest, TakesTickSizesFromConfig)
+{
+  EngineConfig cfg;
+  cfg.exchanges.push_back({"bybit", "linear", {{"BTCUSDT", 0.1, 0.0}, {"DOGEUSDT", 0.00001, 0.0}}});
+  cfg.exchanges.push_back({"binance", "spot", {{"BTCUSDT", 0.01, 0.0}}});
+
+  SymbolRegistry registry;
+  OrderBookSet<> books{1, 8, NoHugePages};
+  EXPECT_EQ(books.addSymbols(cfg, registry), 3u);
+
+  const auto btc = registry.getSymbolId("bybit", "BTCUSDT");
+  const auto doge = registry.getSymbolId("bybit", "DOGEUSDT");
+  const auto spot = registry.getSymbolId("binance", "BTCUSDT");
+  ASSERT_TRUE(btc && doge && spot);
+  EXPECT_EQ(books.find(*btc)->tickSize(), Price::fromDouble(0.1));
+  EXPECT_EQ(books.find(*doge)->tickSize(), Price::fromDouble(0.00001));
+  EXPECT_EQ(books.find(*spot)->tickSize(), Price::fromDouble(0.01));
+}
+
+TEST(OrderBookSetTest, OneSubscriptionServesEverySymbol)
+{
+  BookUpdateBus bus;
+  BookUpdatePool pool;
+  auto books = std::make_unique<OrderBookSet<>>(1, 4, NoHugePages);
+  for (SymbolId s = 0; s < 4; ++s)
+  {
+    books->addSymbol(s, Price::fromDouble(0.1));
+  }
+  bus.subscribe(books.get());
+  bus.start();
+
+  for (int n = 1; n <= 1000; ++n)
+  {
+    const SymbolId s = n % 4;
+    const double bid = 100.0 + s;
+    bus.publish(make(pool, s, n <= 4 ? BookUpdateType::SNAPSHOT : BookUpdateType::DELTA, n,
+                     {level(bid, n)}, {level(bid + 0.1, n)}));
+  }
+  bus.flush();
+  bus.stop();
+
+  for (SymbolId s = 0; s < 4; ++s)
+  {
+    const auto* book = books->find(s);
+    ASSERT_NE(book, nullptr);
+    EXPECT_EQ(book->bestBid(), Price::fromDouble(100.0 + s));
+    // The last update of symbol s was n = 996 + s (n = 1000 for symbol 0)
+    const double last = s == 0 ? 1000 : 996 + s;
+    EXPECT_EQ(book->bidAtPrice(Price::fromDouble(100.0 + s)), Quantity::fromDouble(last));
+  }
+}
@@ -0,0 +1,102 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/util/concurrency/seqlock.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace flox;
+
+namespace
+{
+
+// Several cache lines, every word carrying the same value, so a torn copy shows up
+struct Wide
+{
+  std::array<uint64_t, 40> words{};
+};
+
+}  // namespace
+
+TEST(SeqLockTest, StoresAndLoads)
+{
+  SeqLock<Wide> lock;
+  EXPECT_EQ(lock.version(), 0u);
+  EXPECT_EQ(lock.load().words[7], 0u);
+
+  Wide w;
+  w.words.fill(42);
+  lock.store(w);
+  EXPECT_EQ(lock.version(), 1u);
+
+  Wide out;
+  ASSERT_TRUE(lock.tryLoad(out));
+  EXPECT_EQ(out.words[39], 42u);
+}
+
+TEST(SeqLockTest, ReadersNeverSeeTornValues)
+{
+  SeqLock<Wide> lock;
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> torn{0}, reads{0};
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r)
+  {
+    readers.emplace_back(
+        [&]
+        {
+          uint64_t last = 0;
+          while (!done.load(std::memory_order_acquire))
+          {
+            const Wide w = lock.load();
+            for (const uint64_t v : w.words)
+            {
+              if (v != w.words[0])
+              {
+                torn.fetch_add(1);
+                break;
+              }
+            }
+            // Values only move forward
+            if (w.words[0] < last)
+            {
+              torn.fetch_add(1);
+            }
+            last = w.words[0];
+            reads.fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+  }
+
+  Wide w;
+  for (uint64_t i = 1; i <= 200'000; ++i)
+  {
+    w.words.fill(i);
+    lock.store(w);
+  }
+  while (reads.load() < 1000)
+  {
+    std::this_thread::yield();
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& t : readers)
+  {
+    t.join();
+  }
+
+  EXPECT_EQ(torn.load(), 0u);
+  EXPECT_EQ(lock.version(), 200'000u);
+  EXPECT_EQ(lock.load().words[0], 200'000u);
+}
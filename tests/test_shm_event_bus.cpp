@@ -0,0 +1,169 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flox/book/events/trade_event.h"
+#include "flox/engine/abstract_market_data_subscriber.h"
+#include "flox/util/eventing/shm_event_bus.h"
+
+using namespace flox;
+
+namespace
+{
+
+using TradeShmBus = SharedMemoryEventBus<TradeEvent, 4>;
+
+class RecordingSubscriber : public IMarketDataSubscriber
+{
+ public:
+  void onTrade(const TradeEvent& ev) override
+  {
+    ids.push_back(ev.trade_id);
+    count.store(ids.size(), std::memory_order_release);
+  }
+
+  SubscriberId id() const override { return 1; }
+
+  std::vector<uint64_t> ids;
+  std::atomic<size_t> count{0};
+};
+
+std::string uniqueName(const char* tag) { return "/flox_test_" + std::string(tag) + "_" + std::to_string(getpid()); }
+
+constexpr uint64_t EventCount = 1000;
+
+}  // namespace
+
+TEST(SharedMemoryEventBusTest, ChildProcessPublishesToParentConsumer)
+{
+  TradeShmBus bus(uniqueName("pub"), 64);
+  RecordingSubscriber sub;
+  bus.subscribe(&sub);
+
+  // Fork before any consumer thread exists; the child fills the ring and waits for space
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0)
+  {
+    TradeShmBus producer(bus.name());
+    for (uint64_t i = 0; i < EventCount; ++i)
+    {
+      TradeEvent ev;
+      ev.trade_id = i;
+      producer.publish(ev);
+    }
+    _exit(0);
+  }
+
+  bus.start();
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  bus.flush();
+  bus.stop();
+
+  ASSERT_EQ(sub.ids.size(), EventCount);
+  for (uint64_t i = 0; i < EventCount; ++i)
+  {
+    EXPECT_EQ(sub.ids[i], i);
+  }
+}
+
+TEST(SharedMemoryEventBusTest, ParentPublishesToChildConsumer)
+{
+  TradeShmBus bus(uniqueName("con"), 64);
+
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0)
+  {
+    bool ok = true;
+    {
+      TradeShmBus consumer(bus.name());
+      RecordingSubscriber sub;
+      consumer.subscribe(&sub);
+      consumer.start();
+      while (sub.count.load(std::memory_order_acquire) < EventCount)
+      {
+        std::this_thread::yield();
+      }
+      consumer.stop();
+
+      ok = sub.ids.size() == EventCount;
+      for (uint64_t i = 0; ok && i < EventCount; ++i)
+      {
+        ok = sub.ids[i] == i;
+      }
+    }  // detaches the consumer cell
+    _exit(ok ? 0 : 1);
+  }
+
+  while (bus.consumerCount() == 0)
+  {
+    std::this_thread::yield();
+  }
+  for (uint64_t i = 0; i < EventCount; ++i)
+  {
+    TradeEvent ev;
+    ev.trade_id = i;
+    bus.publish(ev);
+  }
+
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+  EXPECT_EQ(bus.consumerCount(), 0u);
+}
+
+TEST(SharedMemoryEventBusTest, AttachRejectsMismatchedLayout)
+{
+  SharedMemoryEventBus<TradeEvent, 4> bus(uniqueName("layout"), 16);
+  EXPECT_THROW((SharedMemoryEventBus<TradeEvent, 8>(bus.name())), std::runtime_error);
+  EXPECT_THROW(TradeShmBus(uniqueName("missing")), std::system_error);
+}
+
+TEST(SharedMemoryEventBusTest, CreateNeverUnlinksLiveRegion)
+{
+  TradeShmBus live(uniqueName("taken"), 16);
+  RecordingSubscriber sub;
+  live.subscribe(&sub);
+  live.start();
+
+  try
+  {
+    TradeShmBus second(live.name(), 16);
+    FAIL() << "creating over a live region must fail";
+  }
+  catch (const std::system_error& e)
+  {
+    EXPECT_EQ(e.code().value(), EEXIST);
+  }
+
+  // The name still refers to the live ring
+  TradeShmBus attached(live.name());
+  TradeEvent ev;
+  ev.trade_id = 7;
+  attached.publish(ev);
+  live.flush();
+  live.stop();
+  ASSERT_EQ(sub.ids.size(), 1u);
+  EXPECT_EQ(sub.ids[0], 7u);
+
+  // Replacing is an explicit choice
+  EXPECT_NO_THROW(TradeShmBus(live.name(), 16, ShmExisting::Replace));
+  EXPECT_THROW(TradeShmBus(uniqueName("odd"), 48), std::invalid_argument);
+}
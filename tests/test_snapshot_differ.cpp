@@ -0,0 +1,136 @@
+/*
+ * Flox Engine
+ * Developed by FLOX Foundation (https://github.com/FLOX-Foundation)
+ *
+ * Copyright (c) 2025 FLOX Foundation
+ * Licensed under the MIT License. See LICENSE file in the project root for full
+ * license information.
+ */
+
+#include "flox/book/bus/book_update_bus.h"
+#include "flox/book/events/book_update_event.h"
+#include "flox/book/snapshot_differ.h"
+
+#include "book_update_helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace flox;
+using namespace flox::test;
+
+namespace
+{
+
+struct Forwarded
+{
+  BookUpdateType type;
+  int64_t seq;
+  int64_t prevSeq;
+  std::vector<BookLevel> bids, asks;
+};
+
+class Collector : public IMarketDataSubscriber
+{
+ public:
+  SubscriberId id() const override { return 99; }
+
+  void onBookUpdate(const BookUpdateEvent& ev) override
+  {
+    events.push_back({ev.update.type, ev.seq, ev.prevSeq,
+                      {ev.update.bids.begin(), ev.update.bids.end()},
+                      {ev.update.asks.begin(), ev.update.asks.end()}});
+  }
+
+  std::vector<Forwarded> events;
+};
+
+void expectLevels(const std::vector<BookLevel>& got, const std::vector<BookLevel>& want)
+{
+  ASSERT_EQ(got.size(), want.size());
+  for (size_t i = 0; i < got.size(); ++i)
+  {
+    EXPECT_EQ(got[i].price, want[i].price) << i;
+    EXPECT_EQ(got[i].quantity, want[i].quantity) << i;
+  }
+}
+
+}  // namespace
+
+TEST(SnapshotDifferTest, RepublishesSnapshotsAsChangedLevels)
+{
+  BookUpdatePool pool;
+  BookUpdateBus out;
+  Collector collector;
+  out.subscribe(&collector);
+  out.start();
+
+  SnapshotDiffer<> differ{1, 7, &out, Price::fromDouble(0.1)};
+
+  differ.onBookUpdate(*make(pool, 7, BookUpdateType::SNAPSHOT, 1,
+                            {level(100.0, 1), level(99.9, 2)}, {level(100.1, 3), level(100.2, 4)}));
+  // Same book again, then one level modified, one removed and one added
+  differ.onBookUpdate(*make(pool, 7, BookUpdateType::SNAPSHOT, 2,
+                            {level(100.0, 1), level(99.9, 2)}, {level(100.1, 3), level(100.2, 4)}));
+  differ.onBookUpdate(*make(pool, 7, BookUpdateType::SNAPSHOT, 3,
+                            {level(100.0, 5), level(99.9, 2)}, {level(100.1, 3), level(100.3, 1)}));
+  // Other symbols are ignored
+  differ.onBookUpdate(*make(pool, 8, BookUpdateType::SNAPSHOT, 4, {level(1.0, 1)}, {}));
+
+  out.flush();
+  out.stop();
+
+  ASSERT_EQ(collector.events.size(), 2u);
+  EXPECT_EQ(differ.published(), 2u);
+  EXPECT_EQ(differ.suppressed(), 1u);
+
+  const auto& first = collector.events[0];
+  EXPECT_EQ(first.type, BookUpdateType::SNAPSHOT);
+  EXPECT_EQ(first.seq, 1);
+  EXPECT_EQ(first.bids.size(), 2u);
+
+  const auto& delta = collector.events[1];
+  EXPECT_EQ(delta.type, BookUpdateType::DELTA);
+  EXPECT_EQ(delta.seq, 3);
+  EXPECT_EQ(delta.prevSeq, 1);
+  expectLevels(delta.bids, {level(100.0, 5)});
+  expectLevels(delta.asks, {level(100.3, 1), level(100.2, 0)});
+
+  EXPECT_EQ(differ.book().askAtPrice(Price::fromDouble(100.3)), Quantity::fromDouble(1));
+  EXPECT_EQ(differ.book().askAtPrice(Price::fromDouble(100.2)), Quantity{});
+}
+
+TEST(SnapshotDifferTest, ForwardsDeltasWithoutNoOpLevels)
+{
+  BookUpdatePool pool;
+  BookUpdateBus out;
+  Collector collector;
+  out.subscribe(&collector);
+  out.start();
+
+  SnapshotDiffer<> differ{1, 7, &out, Price::fromDouble(0.1)};
+  differ.onBookUpdate(*make(pool, 7, BookUpdateType::SNAPSHOT, 1, {level(100.0, 1)}, {level(100.1, 1)}));
+  differ.onBookUpdate(*make(pool, 7, BookUpdateType::DELTA, 2, {level(100.0, 1), level(99.8, 2)}, {}));
+  differ.onBookUpdate(*make(pool, 7, BookUpdateType::DELTA, 3, {level(100.0, 1)}, {level(100.5, 0)}));
+
+  out.flush();
+  out.stop();
+
+  ASSERT_EQ(collector.events.size(), 2u);
+  expectLevels(collector.events[1].bids, {level(99.8, 2)});
+  EXPECT_TRUE(collector.events[1].asks.empty());
+  EXPECT_EQ(differ.suppressed(), 1u);
+  EXPECT_EQ(differ.book().bidAtPrice(Price::fromDouble(99.8)), Quantity::fromDouble(2));
+}
+
+TEST(SnapshotDifferTest, MaintainsTheBookWithoutAnOutputBus)
+{
+  BookUpdatePool pool;
+  SnapshotDiffer<> differ{1, 7, nullptr, Price::fromDouble(0.1)};
+  differ.onBookUpdate(*make(pool, 7, BookUpdateType::SNAPSHOT, 1, {level(100.0, 1)}, {level(100.1, 1)}));
+  differ.onBookUpdate(*make(pool, 7, BookUpdateType::SNAPSHOT, 2, {level(99.9, 2)}, {level(100.1, 1)}));
+
+  EXPECT_EQ(differ.book().bestBid(), Price::fromDouble(99.9));
+  EXPECT_EQ(differ.published(), 0u);
+}